@@ -51,7 +51,9 @@ public class Logi : ModuleRules
                 "AssetRegistry",
                 "BlueprintGraph",
                 "AssetRegistry",
-                "EditorStyle"
+                "EditorStyle",
+                "LogiRuntime",
+                "LogiRendering"
 				
 
 				// ... add private dependencies that you statically link with here ...	
@@ -7,28 +7,34 @@
 #include "MaterialDomain.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "EngineUtils.h"
+#include "Animation/SkeletalMeshActor.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/StaticMeshActor.h"
+#include "ThermalComponent.h"
 #include "Utils/ActorUtils.h"
 #include "Utils/BlueprintUtils.h"
 
 
 namespace Logi::ActorPatcher
 {
-	// Creates Thermal Material on already existing material of the actor(?)
-	void CreateThermalMaterial(bool& bSuccess, FString& StatusMessage) {
+	// Creates a thermal material that wraps the given thermal material function
+	void CreateThermalMaterialAsset(const FString& MaterialName, const FString& FunctionPath, bool& bSuccess, FString& StatusMessage) {
 		#if WITH_EDITOR
 			bSuccess = false;
 
 			//Load the thermal material function
-			UMaterialFunctionInterface* ThermalMaterialFunction = LoadObject<UMaterialFunctionInterface>(nullptr, TEXT("/Game/Logi_ThermalCamera/Materials/MF_Logi_ThermalMaterialFunction.MF_Logi_ThermalMaterialFunction"));
+			UMaterialFunctionInterface* ThermalMaterialFunction = LoadObject<UMaterialFunctionInterface>(nullptr, *FunctionPath);
 
 			//Check if the function was loaded successfully
 			if (!ThermalMaterialFunction) {
-				StatusMessage = TEXT("Failed to load MF_Logi_ThermalMaterialFunction in CreateThermalMaterial. Thermal material could not be created.");
+				StatusMessage = FString::Printf(TEXT("Failed to load %s in CreateThermalMaterial. Thermal material could not be created."), *FunctionPath);
 				return;
 			}
 
 			// Define names, paths and packages
-			const FString MaterialName = TEXT("M_Logi_ThermalMaterial");
 			const FString PackagePath = TEXT("/Game/Logi_ThermalCamera/Materials/");
 			const FString MaterialPath = PackagePath + MaterialName;
 			UPackage* Package = CreatePackage(*MaterialPath);
@@ -53,6 +59,8 @@ namespace Logi::ActorPatcher
 			Material->BlendMode = BLEND_Opaque;
 			Material->SetShadingModel(MSM_DefaultLit);
 			Material->bUseMaterialAttributes = true;
+			Material->bUsedWithInstancedStaticMeshes = true;
+			Material->bUsedWithSkeletalMesh = true;
 
 			// Create a node for the MF_Logi_ThermalMaterialFunction
 			UMaterialExpressionMaterialFunctionCall* FunctionCall = NewObject<UMaterialExpressionMaterialFunctionCall>(Material);
@@ -86,14 +94,40 @@ namespace Logi::ActorPatcher
 			}
 
 			bSuccess = true;
-			StatusMessage = TEXT("Successfully created thermal material.");
+			StatusMessage = FString::Printf(TEXT("Successfully created thermal material %s."), *MaterialName);
 
 		#else
-			success = false;
-			statusMessage = TEXT("The function CreateThermalMaterial can only be run in editor builds");
+			bSuccess = false;
+			StatusMessage = TEXT("The function CreateThermalMaterial can only be run in editor builds");
 		#endif
 	}
 
+	void CreateThermalMaterial(bool& bSuccess, FString& StatusMessage) {
+		//Material used in the dynamic material instance mode, every thermal actor gets its own instance of it
+		CreateThermalMaterialAsset(TEXT("M_Logi_ThermalMaterial"), TEXT("/Game/Logi_ThermalCamera/Materials/MF_Logi_ThermalMaterialFunction.MF_Logi_ThermalMaterialFunction"), bSuccess, StatusMessage);
+
+		if (!bSuccess) return;
+
+		UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+		//Material used in the custom primitive data mode, shared by every thermal mesh
+		CreateThermalMaterialAsset(TEXT("M_Logi_ThermalMaterial_CPD"), TEXT("/Game/Logi_ThermalCamera/Materials/MF_Logi_ThermalMaterialFunction_CPD.MF_Logi_ThermalMaterialFunction_CPD"), bSuccess, StatusMessage);
+
+		if (!bSuccess) return;
+
+		UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+		//Material used on instanced static meshes, every instance reads its temperatures from per instance custom data
+		CreateThermalMaterialAsset(TEXT("M_Logi_ThermalMaterial_Instanced"), TEXT("/Game/Logi_ThermalCamera/Materials/MF_Logi_ThermalMaterialFunction_Instanced.MF_Logi_ThermalMaterialFunction_Instanced"), bSuccess, StatusMessage);
+
+		if (!bSuccess) return;
+
+		UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+		//Material used on skeletal meshes, every material slot reads its own temperature from custom primitive data
+		CreateThermalMaterialAsset(TEXT("M_Logi_ThermalMaterial_Skeletal"), TEXT("/Game/Logi_ThermalCamera/Materials/MF_Logi_ThermalMaterialFunction_Skeletal.MF_Logi_ThermalMaterialFunction_Skeletal"), bSuccess, StatusMessage);
+	}
+
 	// Finds all Actor blueprints in the project, that are not Logi-created
 	void FindAllNonLogiActorBlueprintsInProject(TArray<FAssetData>& OutActorBlueprints) {
 		//Get the asset registry module
@@ -147,615 +181,181 @@ namespace Logi::ActorPatcher
 		}
 	}
 
-	void AddLogiVariablesToActorBlueprint(const FAssetData& Actor) {
+	void AddThermalComponentToActorBlueprint(const FAssetData& Actor) {
 
 		//Cast asset data to blueprint type
 		UBlueprint* Blueprint = Cast<UBlueprint>(Actor.GetAsset());
 
 		//Validate that the cast was successfull
-		if(!Blueprint) {
+		if (!Blueprint || !Blueprint->SimpleConstructionScript) {
 			UE_LOG(LogTemp, Error, TEXT("Failed to load blueprint from asset data: %s"), *Actor.AssetName.ToString());
 			return;
 		}
 
-		//Create bolean type
-		FEdGraphPinType BoolType;
-		BoolType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-
-		//Create float type
-		FEdGraphPinType FloatType;
-		FloatType.PinCategory = UEdGraphSchema_K2::PC_Real;
-		FloatType.PinSubCategory = UEdGraphSchema_K2::PC_Float;
-
-		//Create index type
-		FEdGraphPinType INTType;
-		INTType.PinCategory = UEdGraphSchema_K2::PC_Int;
-
-		//Create Linear Color type
-		FEdGraphPinType linearColorType;
-		linearColorType.PinCategory = UEdGraphSchema_K2::PC_Struct;
-		linearColorType.PinSubCategoryObject = TBaseStructure<FLinearColor>::Get();
-
-		//Create vector type
-		FEdGraphPinType VectorType;
-		VectorType.PinCategory = UEdGraphSchema_K2::PC_Struct;
-		VectorType.PinSubCategoryObject = TBaseStructure<FVector>::Get();
-
-		//Print status
-		UE_LOG(LogTemp, Warning, TEXT("Adding variable to actor blueprint"));
-
-		//Add variables to the blueprint
-		BlueprintUtils::AddVariableToBlueprintClass(Blueprint, "Logi_Hot", BoolType, true, "false");
-		BlueprintUtils::AddVariableToBlueprintClass(Blueprint, "Logi_BaseTemperature", FloatType, true, "0.0");
-		BlueprintUtils::AddVariableToBlueprintClass(Blueprint, "Logi_MaxTemperature", FloatType, true, "25.0");
-		BlueprintUtils::AddVariableToBlueprintClass(Blueprint, "Logi_CurrentTemperature", FloatType, true, "10.0");
-		BlueprintUtils::AddVariableToBlueprintClass(Blueprint, "Logi_MaterialIndex", INTType, false, "0");
-	}
-
-	void AddNodeSetupToSetupFunction(UEdGraph* FunctionGraph, const UK2Node_FunctionEntry* EntryNode) {
-		//Validate function graph
-
-		if (!FunctionGraph) {
-			UE_LOG(LogTemp, Error, TEXT("Function graph is a nullpointer, cannot add nodes to the graph."));
-			return;
-		}
-
-		//validate entry node
-		if (!EntryNode) {
-			UE_LOG(LogTemp, Error, TEXT("No function entry node is a nullpointer. Cannot add nodes to the graph."));
-			return;
-		}
-
-		// Find the function blueprint
-		UBlueprint* Blueprint = Cast<UBlueprint>(FunctionGraph->GetOuter());
-
-		//Validate the blueprint
-		if (!Blueprint) {
-			UE_LOG(LogTemp, Error, TEXT("Could not find the blueprint linked to the blueprint function"));
-			return;
-		}
-
-		int XPosition = 300;
-
-		//Check every variable in the blueprint for mesh components
-		TArray<FName> MeshComponentNames = ActorUtils::FindAllMeshComponentsInBlueprint(Blueprint);
-
-		//Check if the meshVariableName is empty if so, skipping implementation.
-		if (MeshComponentNames.Num() == 0) {
-			UE_LOG(LogTemp, Warning, TEXT("No skeletal mesh component found in blueprint '%s', skipping implementation."), *Blueprint->GetName());
-			return;
-		}
-
-		//Get the function graphs schema
-		const UEdGraphSchema_K2* Schema = CastChecked<UEdGraphSchema_K2>(FunctionGraph->GetSchema());
-
-		//Create Logi_Hot variable getter node
-		const UK2Node_VariableGet* LogiHotGetNode = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_Hot"), XPosition, 200);
-
-		//Update xPosition
-		XPosition += 100;
-
-		//Creating nodes inside the function graph
-		const UK2Node_IfThenElse* BranchNode = BlueprintUtils::CreateBPBranchNode(FunctionGraph, XPosition, 0);
-
-		//Update xPosition
-		XPosition += 300;
-
-		//Connect the entry node to the branch node
-		UEdGraphPin* ExecPin = EntryNode->FindPin(UEdGraphSchema_K2::PN_Then);
-
-		//Connect the Logi_Hot variable getter node to the branch node
-		Schema->TryCreateConnection(LogiHotGetNode->FindPin(FName("Logi_Hot")), BranchNode->GetConditionPin());
-
-		//Connect the entry node to the branch node
-		Schema->TryCreateConnection(ExecPin, BranchNode->GetExecPin());
-
-		// Pointers to track the last SetRenderCustomDepth node in the true/false chain
-		const UK2Node_CallFunction* PreviousTrueExecNode = nullptr;
-		const UK2Node_CallFunction* PreviousFalseExecNode = nullptr;
+		USimpleConstructionScript* ConstructionScript = Blueprint->SimpleConstructionScript;
 
-		//Create mesh getter nodes and set render custom deapth node for each mesh in the blueprint
-		for (int32 i = 0; i < MeshComponentNames.Num(); ++i) {
-
-			//Get the mesh variable name
-			FName MeshVariableName = MeshComponentNames[i];
-
-			//Create mesh getter nodes
-			const UK2Node_VariableGet* MeshGetterNodeTrue = Logi::BlueprintUtils::CreateBPGetterNode(FunctionGraph, MeshVariableName, XPosition, -400);
-			const UK2Node_VariableGet* MeshGetterNodeFalse = Logi::BlueprintUtils::CreateBPGetterNode(FunctionGraph, MeshVariableName, XPosition, 500);
-
-			//Create set render custom depth nodes
-			UK2Node_CallFunction* SetRenderDepthNodeTrue = Logi::BlueprintUtils::CreateBPSetRenderDepthNode(FunctionGraph, true, XPosition, -200);
-			UK2Node_CallFunction* SetRenderDepthNodeFalse = Logi::BlueprintUtils::CreateBPSetRenderDepthNode(FunctionGraph, false, XPosition, 200);
-
-			//Try to find the target pin for the set render custom depth nodes
-			UEdGraphPin* TrueTargetPin = SetRenderDepthNodeTrue->FindPin(UEdGraphSchema_K2::PN_Self);
-			UEdGraphPin* FalseTargetPin = SetRenderDepthNodeFalse->FindPin(UEdGraphSchema_K2::PN_Self);
-
-			//Connect mesh getter nodes to set render custom depth nodes
-			if (TrueTargetPin && MeshGetterNodeTrue->GetValuePin()) {
-				Schema->TryCreateConnection(MeshGetterNodeTrue->GetValuePin(), TrueTargetPin);
-			}
-
-			if (FalseTargetPin && MeshGetterNodeFalse->GetValuePin()) {
-				Schema->TryCreateConnection(MeshGetterNodeFalse->GetValuePin(), FalseTargetPin);
-			}
-
-			//Check if this is the first set render custom depth node in the chains
-			if (i == 0) {
-				//Connect the branch node to the set render custom depth nodes
-				Schema->TryCreateConnection(BranchNode->GetThenPin(), SetRenderDepthNodeTrue->GetExecPin());
-				Schema->TryCreateConnection(BranchNode->GetElsePin(), SetRenderDepthNodeFalse->GetExecPin());
-
-				//Set the previous set render custom depth nodes to the current set render custom depth nodes
-			}
-			else {
-				//Connect the previous set render custom depth node to the current set render custom depth node
-				Schema->TryCreateConnection(PreviousTrueExecNode->GetThenPin(), SetRenderDepthNodeTrue->GetExecPin());
-				Schema->TryCreateConnection(PreviousFalseExecNode->GetThenPin(), SetRenderDepthNodeFalse->GetExecPin());
+		//Check if the blueprint already has a thermal component
+		for (const USCS_Node* Node : ConstructionScript->GetAllNodes()) {
+			if (Node && Node->ComponentClass && Node->ComponentClass->IsChildOf(UThermalComponent::StaticClass())) {
+				UE_LOG(LogTemp, Warning, TEXT("Blueprint '%s' already has a thermal component, skipping implementation."), *Blueprint->GetName());
+				return;
 			}
-
-			//Set the previous set render custom depth nodes to the current set render custom depth nodes
-			PreviousTrueExecNode = SetRenderDepthNodeTrue;
-			PreviousFalseExecNode = SetRenderDepthNodeFalse;
-		
-			//Update xPosition
-			XPosition += 300;
 		}
 
-		//create get all actors of class node
-		const UK2Node_CallFunction* GetAllActorsOfClassNode = Logi::BlueprintUtils::CreateBPGetAllActorsOfClassNode(FunctionGraph, XPosition, 0);
-
-		//Connect Get all actors of class node to the render custom depth node.
-		Schema->TryCreateConnection(PreviousTrueExecNode->GetThenPin(), GetAllActorsOfClassNode->GetExecPin());
-		Schema->TryCreateConnection(PreviousFalseExecNode->GetThenPin(), GetAllActorsOfClassNode->GetExecPin());
-
-
-		//find the actor class pin of the Get all actors of class node
-		UEdGraphPin* actorClassPin = GetAllActorsOfClassNode->FindPin(FName("ActorClass"));
-
-		//validate the actor class pin
-		if (!actorClassPin) {
-			UE_LOG(LogTemp, Error, TEXT("Failed to find the actor class pin in the Get All Actors of Class node"));
+		//Check if the parent class already creates a thermal component
+		const AActor* ActorDefaultObject = Blueprint->GeneratedClass ? Cast<AActor>(Blueprint->GeneratedClass->GetDefaultObject()) : nullptr;
+		if (ActorDefaultObject && ActorDefaultObject->FindComponentByClass<UThermalComponent>()) {
+			UE_LOG(LogTemp, Warning, TEXT("Parent class of blueprint '%s' already has a thermal component, skipping implementation."), *Blueprint->GetName());
 			return;
 		}
 
-		//Find the Logi_ThermalController blueprint
-		UBlueprint* ControllerBP = Cast<UBlueprint>(StaticLoadObject(UBlueprint::StaticClass(), nullptr, TEXT("/Game/Logi_ThermalCamera/Actors/BP_Logi_ThermalController.BP_Logi_ThermalController")));
-
-		//Validate the thermal controller blueprint
-		if (!ControllerBP || !ControllerBP->GeneratedClass)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to load BP_Logi_ThermalController or its generated class"));
+		//Check if the blueprint has any meshes that can show a temperature
+		if (ActorUtils::FindAllMeshComponentsInBlueprint(Blueprint).Num() == 0) {
+			UE_LOG(LogTemp, Warning, TEXT("No mesh component found in blueprint '%s', skipping implementation."), *Blueprint->GetName());
 			return;
 		}
 
-		//Set the actor class pin to the BP_Logi_ThermalController class
-		actorClassPin->DefaultObject = ControllerBP->GeneratedClass;
-
-		//Notify actor class pin that the pin has changed
-		actorClassPin->GetSchema()->TrySetDefaultObject(*actorClassPin, ControllerBP->GeneratedClass);
-
-
-		//update xPosition
-		XPosition += 300;
-
-		//Create array getter node
-		UK2Node_GetArrayItem* ArrayGetNode = Logi::BlueprintUtils::CreateBPArrayGetterNode(FunctionGraph, XPosition, 200);
-
-		//Find the array input pin of the array getter node
-		UEdGraphPin* ArrayInputPin = ArrayGetNode->GetTargetArrayPin();
-
-
-		//Connect the get all actors of class node to the array getter node
-		Schema->TryCreateConnection(GetAllActorsOfClassNode->FindPin(FName("OutActors")), ArrayInputPin);
-
-		//Notify the array getter node that the input pin has changed to update the pins name to the correct type
-		ArrayInputPin->GetOwningNode()->PinConnectionListChanged(ArrayInputPin);
-
-		//Reconstruct pins for the array getter node to account for the array type
-		ArrayGetNode->ReconstructNode();
+		//Print status
+		UE_LOG(LogTemp, Warning, TEXT("Adding thermal component to actor blueprint"));
 
+		//Create the thermal component node and add it to the construction script
+		USCS_Node* ThermalComponentNode = ConstructionScript->CreateNode(UThermalComponent::StaticClass(), FName("Logi_Thermal"));
+		ConstructionScript->AddNode(ThermalComponentNode);
 
-		//Find the index input pin of the array getter node
-		UEdGraphPin* IndexPin = nullptr;
-		//Iterate through all pins of the getter node
-		for (UEdGraphPin* Pin : ArrayGetNode->Pins)
-		{
-			//Check if the pin's direction is an input pin and if the type is an integer, if so it is the index pin.
-			if (Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int && Pin->Direction == EGPD_Input)
-			{
-				IndexPin = Pin;
-				break;
-			}
-		}
-		
-		//Validate index pin and set the index pins value
-		if (IndexPin) {
-			IndexPin->DefaultValue = TEXT("0");
-		}
-		else {
-			UE_LOG(LogTemp, Error, TEXT("Failed to find the index pin in the array getter node"));
-			return;
+		//Carry over the temperatures of blueprints patched by earlier versions of the plugin
+		if (UThermalComponent* ThermalComponentTemplate = Cast<UThermalComponent>(ThermalComponentNode->ComponentTemplate)) {
+			CopyLegacyLogiVariablesToThermalComponent(Blueprint, ThermalComponentTemplate);
 		}
 
-		//Update xPosition
-		XPosition += 300;
+		//Remove the blueprint variables and functions that the thermal component replaces
+		RemoveLegacyLogiSetupFromBlueprint(Blueprint);
 
-		//Set thermal controller variable name
-		const FName ThermalControllerVariableName = FName("Logi_ThermalController");
+		//Mark blueprint as modified
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 
-		//Adds thermal controller referense variable
-		Logi::BlueprintUtils::AddThermalControllerReferenceToBlueprint(Blueprint, ThermalControllerVariableName, false);
-		
-		
-		//Create a variable setter node for the Logi_ThermalController variable
-		const UK2Node_VariableSet* SetThermalController = Logi::BlueprintUtils::CreateBPSetterNode(FunctionGraph, ThermalControllerVariableName, XPosition, 0);
+		UE_LOG(LogTemp, Log, TEXT("Thermal component successfully added to blueprint '%s'."), *Blueprint->GetName());
+	}
 
-		//Connect the array getter node to the setThermalController node
-		Schema->TryCreateConnection(ArrayGetNode->GetResultPin(), SetThermalController->FindPin(ThermalControllerVariableName));
+	void CopyLegacyLogiVariablesToThermalComponent(const UBlueprint* Blueprint, UThermalComponent* ThermalComponent) {
+		//Validate the blueprint
+		if (!Blueprint || !Blueprint->GeneratedClass || !ThermalComponent) return;
 
+		const UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
 
-		const UEdGraphPin* ThenPin = GetAllActorsOfClassNode->FindPin(UEdGraphSchema_K2::PN_Then);
-		if (!ThenPin)
+		//Read a float variable from the class default object, returns false if the blueprint does not have it
+		const TFunction<bool(const FName&, float&)> GetFloatVariable = [&](const FName& VariableName, float& OutValue)
 		{
-			UE_LOG(LogTemp, Error, TEXT("GetAllActorsOfClass node does not have a Then pin!"));
-		}
-
-		//Connect the setter node for Logi thermal controller and get all actors of class node's exec pins
-		Schema->TryCreateConnection(SetThermalController->GetExecPin(), GetAllActorsOfClassNode->GetThenPin());
-
-		//Update xPosition
-		XPosition += 300;
+			const FNumericProperty* NumericProp = FindFProperty<FNumericProperty>(Blueprint->GeneratedClass, VariableName);
 
-		//Create dynamic material instance node
-		const UK2Node_CallFunction* DynamicMaterialInstanceNode = Logi::BlueprintUtils::CreateBPDynamicMaterialInstanceNode(FunctionGraph, XPosition, 0);
+			if (!NumericProp) {
+				return false;
+			}
 
-		// Find the parent pin of the dynamic material instance node
-		UEdGraphPin* ParentPin = DynamicMaterialInstanceNode->FindPin(TEXT("Parent"));
+			OutValue = static_cast<float>(NumericProp->GetFloatingPointPropertyValue(NumericProp->ContainerPtrToValuePtr<void>(DefaultObject)));
+			return true;
+		};
 
-		//Find the Logi_ThermalMaterial
-		const FString ThermalMaterialFilePath = TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial.M_Logi_ThermalMaterial");
-		UObject* ThermalMaterial = StaticLoadObject(UMaterialInterface::StaticClass(), nullptr, *ThermalMaterialFilePath);
-		//UMaterialInterface* thermalMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial.M_Logi_ThermalMaterial"));
+		float Value = 0.0f;
 
-		//Set the parent pin to the logi thermal material
-		if (ParentPin && ThermalMaterial)
-		{
-			ParentPin->DefaultObject = ThermalMaterial;
+		if (GetFloatVariable(FName("Logi_BaseTemperature"), Value)) {
+			ThermalComponent->SetBaseTemperature(Value);
 		}
 
-		
-		// Connect execution from previous setter
-		Schema->TryCreateConnection(SetThermalController->GetThenPin(), DynamicMaterialInstanceNode->GetExecPin());
-
-		//Add dynamic material instance variable to blueprint
-		const FName DynamicMaterialInstanceVariableName = Logi::BlueprintUtils::AddMaterialInstanceVariableToBlueprint(Blueprint);
-
-		// Update xPosition
-		XPosition += 500;
-
-		//Create a setter node for the dynamic material instance variable
-		const UK2Node_VariableSet* SetDynamicMaterialInstanceNode = Logi::BlueprintUtils::CreateBPSetterNode(FunctionGraph, DynamicMaterialInstanceVariableName, XPosition, 0);
-
-		//Connect exec pin of the dynamic material instance node to the setter node
-		Schema->TryCreateConnection(DynamicMaterialInstanceNode->GetThenPin(), SetDynamicMaterialInstanceNode->GetExecPin());
-
-		//Connect the return value of the dynamic material instance node to the setter node
-		Schema->TryCreateConnection(DynamicMaterialInstanceNode->FindPin(TEXT("ReturnValue")), SetDynamicMaterialInstanceNode->FindPin(DynamicMaterialInstanceVariableName.ToString()));
-
-	}
-
-	void AddNodeSetupToUpdateThermalMaterialFunction(UEdGraph* FunctionGraph, const UK2Node_FunctionEntry* EntryNode) {
-		//Validate function graph
-
-		if (!FunctionGraph) {
-			UE_LOG(LogTemp, Error, TEXT("Function graph is a nullpointer, cannot add nodes to the graph."));
-			return;
+		if (GetFloatVariable(FName("Logi_MaxTemperature"), Value)) {
+			ThermalComponent->SetMaxTemperature(Value);
 		}
 
-		//validate entry node
-		if (!EntryNode) {
-			UE_LOG(LogTemp, Error, TEXT("No function entry node is a nullpointer. Cannot add nodes to the graph."));
-			return;
+		if (GetFloatVariable(FName("Logi_CurrentTemperature"), Value)) {
+			ThermalComponent->SetCurrentTemperature(Value);
 		}
 
-		// Find the function blueprint
-		const UBlueprint* blueprint = Cast<UBlueprint>(FunctionGraph->GetOuter());
-
-		//Validate the blueprint
-		if (!blueprint) {
-			UE_LOG(LogTemp, Error, TEXT("Could not find the blueprint linked to the blueprint function"));
-			return;
+		if (const FBoolProperty* HotProp = FindFProperty<FBoolProperty>(Blueprint->GeneratedClass, FName("Logi_Hot"))) {
+			ThermalComponent->SetHot(HotProp->GetPropertyValue_InContainer(DefaultObject));
 		}
+	}
 
-		//Check every variable in the blueprint for mesh components
-		 TArray<USCS_Node*> meshComponents = ActorUtils::FindUscsNodesForMeshComponentsFromBlueprint(blueprint);
+	void RemoveLegacyLogiSetupFromBlueprint(UBlueprint* Blueprint) {
 
-		//Check if the meshVariableName is empty if so, skipping implementation.
-		if (meshComponents.Num() == 0) {
-			UE_LOG(LogTemp, Warning, TEXT("No mesh component found in blueprint '%s', skipping implementation."), *blueprint->GetName());
-			return;
+		// Finds the blueprints event graph
+		UEdGraph* EventGraph = nullptr;
+		for (UEdGraph* Graph : Blueprint->UbergraphPages) {
+			if (Graph && Graph->GetFName() == FName(TEXT("EventGraph"))) {
+				EventGraph = Graph;
+				break;
+			}
 		}
 
-		//Get the function graphs schema
-		const UEdGraphSchema_K2* Schema = CastChecked<UEdGraphSchema_K2>(FunctionGraph->GetSchema());
-
-		int xPosition = 300;
-
-		//create branch node for ThermalControllerActive variable
-		const UK2Node_IfThenElse* branchNode = BlueprintUtils::CreateBPBranchNode(FunctionGraph, xPosition, 0);
-
-		//Thermal Controller filepath
-		const TCHAR* thermalControllerFilePath = TEXT("/Game/Logi_ThermalCamera/Actors/BP_Logi_ThermalController.BP_Logi_ThermalController_C");
-
-
-		//Get Thermal Controllers ThermalCameraActive variable
-		const UK2Node_VariableGet* getThermalController = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_ThermalController"), xPosition - 500, 200);
-		const UK2Node_VariableGet* getThermalControllerThermalCameraActive = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraActive"), thermalControllerFilePath, xPosition - 300,200);
-
-		//Connect ThermalController getter node to the external getter node
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), getThermalControllerThermalCameraActive->FindPin(FName("self")));
-
-		//connect ThermalControllerActive getter node to branch nodes condition pin
-		branchNode->GetConditionPin()->MakeLinkTo(getThermalControllerThermalCameraActive->FindPin(FName("ThermalCameraActive")));
-
-		//Connect the entry node to the branch node
-		Schema->TryCreateConnection(EntryNode->FindPin(UEdGraphSchema_K2::PN_Then), branchNode->GetExecPin());
-
-		xPosition += 300;
-
-		//create setter nodes for Logi material index
-		const UK2Node_VariableSet* setLogiMaterialIndexNodeZero = BlueprintUtils::CreateBPSetterNode(FunctionGraph, FName("Logi_MaterialIndex"), xPosition, 100);
-		const UK2Node_VariableSet* setLogiMaterialIndexNodeOne = BlueprintUtils::CreateBPSetterNode(FunctionGraph, FName("Logi_MaterialIndex"), xPosition, -100);
-
-		//set Logi material index pin to 0
-		UEdGraphPin* setLogiMaterialIndexNodeZeroPin = setLogiMaterialIndexNodeZero->FindPin(FName("Logi_MaterialIndex"));
-		setLogiMaterialIndexNodeZeroPin->DefaultValue = TEXT("0");
-		//set Logi material index pin to 1
-		UEdGraphPin* setLogiMaterialIndexNodeOnePin = setLogiMaterialIndexNodeOne->FindPin(FName("Logi_MaterialIndex"));
-		setLogiMaterialIndexNodeOnePin->DefaultValue = TEXT("1");
-
-		//Connect the branch node to the setter nodes
-		Schema->TryCreateConnection(branchNode->GetThenPin(), setLogiMaterialIndexNodeOne->GetExecPin());
-		Schema->TryCreateConnection(branchNode->GetElsePin(), setLogiMaterialIndexNodeZero->GetExecPin());
-
-		xPosition += 600;
-
-		//create set scalar parameter value node for CurrentTemperature
-		const UK2Node_CallFunction* SetCurrentTemperatureScalarParameterNode = BlueprintUtils::CreateBPDynamicMaterialInstanceScalarParameterNode(FunctionGraph, xPosition, 0);
-		SetCurrentTemperatureScalarParameterNode->FindPin(FName("ParameterName"))->DefaultValue = TEXT("CurrentTemperature");
-
-		//create getter node for getLogiDynamicMaterialInstance and connect it to the current temperature node
-		const UK2Node_VariableGet* GetLogiLogiDynamicMaterialInstance = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_DynamicMaterialInstance"), xPosition - 300, 100);
-		Schema->TryCreateConnection(GetLogiLogiDynamicMaterialInstance->GetValuePin(), SetCurrentTemperatureScalarParameterNode->FindPin(FName("self")));
-		Schema->TryCreateConnection(setLogiMaterialIndexNodeZero->GetThenPin(), SetCurrentTemperatureScalarParameterNode->GetExecPin());
-		Schema->TryCreateConnection(setLogiMaterialIndexNodeOne->GetThenPin(), SetCurrentTemperatureScalarParameterNode->GetExecPin());
-		
-		//create normalize to range node setup for CurrentTemperature
-		const UK2Node_CallFunction* NormalizeToRangeNode = BlueprintUtils::CreateBPNormalizeToRangeNode(FunctionGraph, xPosition, 300);
-		const UK2Node_VariableGet* GetLogiCurrentTemperature =  BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_CurrentTemperature"), xPosition - 250, 300);
-		Schema->TryCreateConnection(GetLogiCurrentTemperature->GetValuePin(), NormalizeToRangeNode->FindPin(FName("Value")));
-		getThermalController = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_ThermalController"), xPosition - 550, 400);
-		const UK2Node_VariableGet* GetThermalControllerThermalCameraRangeMin = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMin"), thermalControllerFilePath, xPosition - 300, 350);
-		const UK2Node_VariableGet* GetThermalControllerThermalCameraRangeMax = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMax"), thermalControllerFilePath, xPosition - 300, 450);
-		
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMin->FindPin(FName("self")));
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMax->FindPin(FName("self")));
-
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMin->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMin")));
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMax->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMax")));
-		Schema->TryCreateConnection(NormalizeToRangeNode->GetReturnValuePin(), SetCurrentTemperatureScalarParameterNode->FindPin(FName("Value")));
+		//Find the Schema of the event graph
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
 
-		
-		xPosition += 800;
-
-		//create set scalar parameter value node for  MaxTemperature node
-		const UK2Node_CallFunction* SetMaxTemperatureScalarParameterNode = BlueprintUtils::CreateBPDynamicMaterialInstanceScalarParameterNode(FunctionGraph, xPosition, 0);
-		SetMaxTemperatureScalarParameterNode->FindPin(FName("ParameterName"))->DefaultValue = TEXT("MaxTemperature");
-		Schema->TryCreateConnection(SetCurrentTemperatureScalarParameterNode->GetThenPin(), SetMaxTemperatureScalarParameterNode->GetExecPin());
-
-		//create normalize to range node setup for MaxTemperature
-		NormalizeToRangeNode = BlueprintUtils::CreateBPNormalizeToRangeNode(FunctionGraph, xPosition, 300);
-		const UK2Node_VariableGet* GetLogiMaxTemperature = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_MaxTemperature"), xPosition - 250, 300);
-		Schema->TryCreateConnection(GetLogiMaxTemperature->GetValuePin(), NormalizeToRangeNode->FindPin(FName("Value")));
-		getThermalController = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_ThermalController"), xPosition - 550, 400);
-		GetThermalControllerThermalCameraRangeMin = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMin"), thermalControllerFilePath, xPosition - 300, 350);
-		GetThermalControllerThermalCameraRangeMax = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMax"), thermalControllerFilePath, xPosition - 300, 450);
-
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMin->FindPin(FName("self")));
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMax->FindPin(FName("self")));
-
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMin->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMin")));
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMax->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMax")));
-		Schema->TryCreateConnection(NormalizeToRangeNode->GetReturnValuePin(), SetMaxTemperatureScalarParameterNode->FindPin(FName("Value")));
-
-
-		//create getter node for getLogiDynamicMaterialInstance and connect it to the Max temperature node
-		GetLogiLogiDynamicMaterialInstance = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_DynamicMaterialInstance"), xPosition - 300, 100);
-		Schema->TryCreateConnection(GetLogiLogiDynamicMaterialInstance->GetValuePin(), SetMaxTemperatureScalarParameterNode->FindPin(FName("self")));
-
-		xPosition += 800;
-
-		//create set scalar parameter value node for  BaseTemperature node
-		const UK2Node_CallFunction* SetBaseTemperatureScalarParameterNode = BlueprintUtils::CreateBPDynamicMaterialInstanceScalarParameterNode(FunctionGraph, xPosition, 0);
-		SetBaseTemperatureScalarParameterNode->FindPin(FName("ParameterName"))->DefaultValue = TEXT("BaseTemperature");
-		Schema->TryCreateConnection(SetMaxTemperatureScalarParameterNode->GetThenPin(), SetBaseTemperatureScalarParameterNode->GetExecPin());
-
-		//create normalize to range node setup for MaxTemperature
-		NormalizeToRangeNode = BlueprintUtils::CreateBPNormalizeToRangeNode(FunctionGraph, xPosition, 300);
-		const UK2Node_VariableGet* GetLogiBaseTemperature = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_BaseTemperature"), xPosition - 250, 300);
-		Schema->TryCreateConnection(GetLogiBaseTemperature->GetValuePin(), NormalizeToRangeNode->FindPin(FName("Value")));
-		getThermalController = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_ThermalController"), xPosition - 550, 400);
-		GetThermalControllerThermalCameraRangeMin = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMin"), thermalControllerFilePath, xPosition - 300, 350);
-		GetThermalControllerThermalCameraRangeMax = BlueprintUtils::CreateBPExternalGetterNode(FunctionGraph, FName("ThermalCameraRangeMax"), thermalControllerFilePath, xPosition - 300, 450);
-
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMin->FindPin(FName("self")));
-		Schema->TryCreateConnection(getThermalController->GetValuePin(), GetThermalControllerThermalCameraRangeMax->FindPin(FName("self")));
-
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMin->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMin")));
-		Schema->TryCreateConnection(GetThermalControllerThermalCameraRangeMax->GetValuePin(), NormalizeToRangeNode->FindPin(FName("RangeMax")));
-		Schema->TryCreateConnection(NormalizeToRangeNode->GetReturnValuePin(), SetBaseTemperatureScalarParameterNode->FindPin(FName("Value")));
-
-		//create getter node for getLogiDynamicMaterialInstance and connect it to the Base temperature node
-		GetLogiLogiDynamicMaterialInstance = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_DynamicMaterialInstance"), xPosition - 300, 100);
-		Schema->TryCreateConnection(GetLogiLogiDynamicMaterialInstance->GetValuePin(), SetBaseTemperatureScalarParameterNode->FindPin(FName("self")));
-
-		xPosition += 600;
-
-		//Create set material node setup for each mesh component in actor blueprint:
-		bool bFirstLoop = true;
-		const UK2Node_CallFunction* PreviousSetMaterialNode = nullptr;
-		for (const USCS_Node* MeshComponent : meshComponents) {
-			//Get the mesh component materials:
-			TArray<UMaterialInterface*> MeshComponentMaterials = ActorUtils::FindAllMaterialsFromActorScsNode(MeshComponent);
-
-			int MaterialIndex = 0;
-
-			//create a set material node for each material in the mesh component
-			for (UMaterialInterface* MeshComponentMaterial : MeshComponentMaterials) {
-				//create set material node
-				UK2Node_CallFunction* SetMaterialNode = BlueprintUtils::CreateBPSetMaterialNode(FunctionGraph, xPosition, 0);
-
-				//Create getter node for the mesh component
-				const UK2Node_VariableGet* MeshComponentGetterNode = BlueprintUtils::CreateBPGetterNode(FunctionGraph, MeshComponent->GetVariableName(), xPosition - 150, 100);
-
-				//Connect the mesh component getter node to the Set material node
-				Schema->TryCreateConnection(MeshComponentGetterNode->GetValuePin(), SetMaterialNode->FindPin(FName("self")));
-
-				//Set the material index of the Set Material node
-				SetMaterialNode->FindPin(FName("ElementIndex"))->DefaultValue = FString::FromInt(MaterialIndex);
-
-				//Create select node
-				const UK2Node_Select* SelectNode = BlueprintUtils::CreateBPSelectNode(FunctionGraph, xPosition, 300);
-
-				//Set the select node's option 0 pin to the mesh component material
-				SelectNode->FindPin(FName("Option 0"))->DefaultObject = MeshComponentMaterial;
-
-				//Create a getter node for the Logi_DynamicMaterialInstance variable
-				const UK2Node_VariableGet* getLogiDynamicMaterialInstance = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_DynamicMaterialInstance"), xPosition - 250, 300);
-
-				//Connect the Logi_DynamicMaterialInstance getter node to the select node
-				Schema->TryCreateConnection(getLogiDynamicMaterialInstance->GetValuePin(), SelectNode->FindPin(FName("Option 1")));
-
-				//Connect the setMaterialNode to the select node
-				Schema->TryCreateConnection(SelectNode->GetReturnValuePin(), SetMaterialNode->FindPin(FName("Material")));
+		//Remove the Logi_ThermalActorSetup call from BeginPlay and the Logi_UpdateThermalMaterial call from Event Tick
+		if (EventGraph) {
+			TArray<UK2Node_CallFunction*> LegacyCallNodes;
+			for (UEdGraphNode* Node : EventGraph->Nodes)
+			{
+				if (UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
+				{
+					const FName MemberName = CallFuncNode->FunctionReference.GetMemberName();
+					if (MemberName == FName("Logi_ThermalActorSetup") || MemberName == FName("Logi_UpdateThermalMaterial"))
+					{
+						LegacyCallNodes.Add(CallFuncNode);
+					}
+				}
+			}
 
+			for (UK2Node_CallFunction* CallFuncNode : LegacyCallNodes) {
+				UEdGraphPin* CallExecPin = CallFuncNode->GetExecPin();
+				UEdGraphPin* CallThenPin = CallFuncNode->GetThenPin();
 
-				//Create getter node for material index
-				const UK2Node_VariableGet* MaterialIndexGetterNode = BlueprintUtils::CreateBPGetterNode(FunctionGraph, FName("Logi_MaterialIndex"), xPosition - 150, 600);
+				//Reconnect the nodes before and after the call node so the rest of the graph keeps running
+				if (CallExecPin && CallThenPin && CallThenPin->LinkedTo.Num() > 0) {
+					UEdGraphPin* NextPin = CallThenPin->LinkedTo[0];
+					TArray<UEdGraphPin*> PreviousPins = CallExecPin->LinkedTo;
 
-				//Connect the material index getter node to the select node
-				Schema->TryCreateConnection(MaterialIndexGetterNode->GetValuePin(), SelectNode->FindPin(FName("Index")));
+					Schema->BreakPinLinks(*CallThenPin, false);
+					Schema->BreakPinLinks(*CallExecPin, false);
 
-				//Connect the exec pin of the select node to the set material node
-				if (bFirstLoop) {
-					Schema->TryCreateConnection(SetBaseTemperatureScalarParameterNode->GetThenPin(), SetMaterialNode->GetExecPin());
-					bFirstLoop = false;
-				}
-				else {
-					Schema->TryCreateConnection(PreviousSetMaterialNode->GetThenPin(), SetMaterialNode->GetExecPin());
+					for (UEdGraphPin* PreviousPin : PreviousPins) {
+						Schema->TryCreateConnection(PreviousPin, NextPin);
+					}
 				}
 
-				PreviousSetMaterialNode = SetMaterialNode;
+				UE_LOG(LogTemp, Warning, TEXT("Removed '%s' call from Blueprint '%s'"), *CallFuncNode->FunctionReference.GetMemberName().ToString(), *Blueprint->GetName());
 
-				MaterialIndex++;
-				xPosition += 600;
+				FBlueprintEditorUtils::RemoveNode(Blueprint, CallFuncNode, true);
 			}
 		}
-	}
-
-	UEdGraph* AddSetupFunctionToNonLogiActor(const FAssetData& Actor) {
-
-		UBlueprint* Blueprint = Cast<UBlueprint>(Actor.GetAsset());
-		const FName FunctionName = FName("Logi_ThermalActorSetup");
-
-
-		//Validate blueprint
-		if (!Blueprint) {
-			UE_LOG(LogTemp, Error, TEXT("Blueprint is null, cannot add setup function."));
-			return nullptr;
-		}
 
-		// Check if the setup function already exists in the blueprint
-		for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
+		//Remove the legacy Logi functions
+		TArray<UEdGraph*> LegacyFunctionGraphs;
+		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
 		{
-			if (Graph && Graph->GetFName() == FunctionName)
+			if (Graph && (Graph->GetFName() == FName("Logi_ThermalActorSetup") || Graph->GetFName() == FName("Logi_UpdateThermalMaterial")))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("Function '%s' already exists in blueprint '%s', skipping implementation."), *FunctionName.ToString(), *Blueprint->GetName());
-				return nullptr;
+				LegacyFunctionGraphs.Add(Graph);
 			}
 		}
 
-
-		// Create the setup function
-		UEdGraph* NewFunctionGraph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
-		FBlueprintEditorUtils::AddFunctionGraph<UFunction>(Blueprint, NewFunctionGraph,true, nullptr);
-
-		// Find the setup function entry node
-		const UK2Node_FunctionEntry* EntryNode = nullptr;
-		for (UEdGraphNode* Node : NewFunctionGraph->Nodes)
-		{
-			EntryNode = Cast<UK2Node_FunctionEntry>(Node);
-			if (EntryNode)
-				break;
+		for (UEdGraph* Graph : LegacyFunctionGraphs) {
+			FBlueprintEditorUtils::RemoveGraph(Blueprint, Graph, EGraphRemoveFlags::Recompile);
 		}
 
-		//Mark blueprint as modified
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-
-		UE_LOG(LogTemp, Log, TEXT("Function 'Logi_ThermalActorSetup' successfully added to blueprint '%s'."), *Blueprint->GetName());
-
-		AddNodeSetupToSetupFunction(NewFunctionGraph, EntryNode);
-
-		return NewFunctionGraph;
-	}
-
-	UEdGraph* AddUpdateThermalMaterialFunctionToNonLogiActor(const FAssetData& Actor) {
-
-		UBlueprint* Blueprint = Cast<UBlueprint>(Actor.GetAsset());
-		const FName FunctionName = FName("Logi_UpdateThermalMaterial");
-
-		//Validate blueprint
-		if (!Blueprint) {
-			UE_LOG(LogTemp, Error, TEXT("Blueprint is null, cannot add setup function."));
-			return nullptr;
-		}
-
-		// Check if the setup function already exists in the blueprint
-		for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
-		{
-			if (Graph && Graph->GetFName() == FunctionName)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Function '%s' already exists in blueprint '%s', skipping implementation."), *FunctionName.ToString(), *Blueprint->GetName());
-				return nullptr;
+		//Remove the legacy Logi variables
+		const TArray<FName> LegacyVariableNames = {
+			FName("Logi_Hot"),
+			FName("Logi_BaseTemperature"),
+			FName("Logi_MaxTemperature"),
+			FName("Logi_CurrentTemperature"),
+			FName("Logi_MaterialIndex"),
+			FName("Logi_ThermalController"),
+			FName("Logi_DynamicMaterialInstance")
+		};
+
+		for (const FName& VariableName : LegacyVariableNames) {
+			if (FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, VariableName) != INDEX_NONE) {
+				FBlueprintEditorUtils::RemoveMemberVariable(Blueprint, VariableName);
 			}
 		}
-
-
-		// Create the setup function
-		UEdGraph* NewFunctionGraph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
-		FBlueprintEditorUtils::AddFunctionGraph<UFunction>(Blueprint, NewFunctionGraph, true, nullptr);
-
-		// Find the setup function entry node
-		UK2Node_FunctionEntry* EntryNode = nullptr;
-		for (UEdGraphNode* Node : NewFunctionGraph->Nodes)
-		{
-			EntryNode = Cast<UK2Node_FunctionEntry>(Node);
-			if (EntryNode)
-				break;
-		}
-
-		//Add node setup to function graph
-		AddNodeSetupToUpdateThermalMaterialFunction(NewFunctionGraph, EntryNode);
-
-
-		//Mark blueprint as modified
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-
-		UE_LOG(LogTemp, Log, TEXT("Function 'Logi_ThermalActorSetup' successfully added to blueprint '%s'."), *Blueprint->GetName());
-
-		return NewFunctionGraph;
 	}
 
 	void MakeProjectBPActorsLogiCompatible() {
@@ -764,188 +364,46 @@ namespace Logi::ActorPatcher
 		//Find all the blueprints of type Actor in the /games (content) folder and add them to the projectActors list
 		FindAllNonLogiActorBlueprintsInProject(ProjectActors);
 
-		//Add Logi variables to all the actor blueprints in the project
-		for (FAssetData Actor : ProjectActors) {
+		//Add a thermal component to all the actor blueprints in the project
+		for (const FAssetData& Actor : ProjectActors) {
 			//Prints status
-			UE_LOG(LogTemp, Warning, TEXT("Adding Logi variables to actor: %s"), *Actor.AssetName.ToString());
-
-			//Add Logi variables to the actor blueprint
-			AddLogiVariablesToActorBlueprint(Actor);
-			//Add Logi functions to the actor blueprint
-			AddSetupFunctionToNonLogiActor(Actor);
-			AddUpdateThermalMaterialFunctionToNonLogiActor(Actor);
-
-			// Gets and validates the Blueprint
-			UBlueprint* Blueprint = Cast<UBlueprint>(Actor.GetAsset());
-			if (!Blueprint) {
-				UE_LOG(LogTemp, Error, TEXT("Failed to cast actor asset '%s' to Blueprint"), *Actor.AssetName.ToString());
-				continue;
-			}
-
-			// Finds the blueprints event graph
-			UEdGraph* EventGraph = nullptr;
-			for (UEdGraph* Graph : Blueprint->UbergraphPages) {
-				if (Graph && Graph->GetFName() == FName(TEXT("EventGraph"))) {
-					EventGraph = Graph;
-					break;
-				}
-			}
-
-			//Validate the event graph
-			if (!EventGraph) {
-				UE_LOG(LogTemp, Error, TEXT("No EventGraph found in Blueprint '%s'"), *Blueprint->GetName());
-				continue;
-			}
-
-			//Find the Schema of the event graph
-			const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
-
-			//Validate the schema
-			if (!Schema) {
-				UE_LOG(LogTemp, Error, TEXT("Failed to get the schema for the EventGraph in Blueprint '%s'"), *Blueprint->GetName());
-				continue;
-			}
-
-			//Check if the Logi_LogiThermalActorSetup function referece nodes already exists in the event graph
-			bool bLogiThermalActorSetupFunctionNodeAlreadyExists = false;
-			for (UEdGraphNode* Node : EventGraph->Nodes)
-			{
-				if (UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
-				{
-					if (CallFuncNode->FunctionReference.GetMemberName() == FName("Logi_ThermalActorSetup"))
-					{
-						bLogiThermalActorSetupFunctionNodeAlreadyExists = true;
-						break;
-					}
-				}
-			}
-
-			//Check if the Logi_UpdateThermalMaterial function referece nodes already exists in the event graph
-			bool bLogiUpdateThermalMaterialFunctionNodeAlreadyExists = false;
-			for (UEdGraphNode* Node : EventGraph->Nodes)
-			{
-				if (UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
-				{
-					if (CallFuncNode->FunctionReference.GetMemberName() == FName("Logi_UpdateThermalMaterial"))
-					{
-						bLogiUpdateThermalMaterialFunctionNodeAlreadyExists = true;
-						break;
-					}
-				}
-			}
-
-
-			// Add call function for Logi_ThermalActorSetup function to actor blueprint if it does not already exist
-			if (!bLogiThermalActorSetupFunctionNodeAlreadyExists) {
-				// Find BeginPlay node
-				UK2Node_Event* BeginPlayNode = nullptr;
-				for (UEdGraphNode* Node : EventGraph->Nodes) {
-					UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-					if (EventNode && EventNode->EventReference.GetMemberName() == FName(TEXT("ReceiveBeginPlay"))) {
-						BeginPlayNode = EventNode;
-						break;
-					}
-				}
-
-				//if the event begin play node is not in the event graph, create it
-				if (!BeginPlayNode) {
-					// If not found, create the BeginPlay event node
-					BeginPlayNode = NewObject<UK2Node_Event>(EventGraph);
-					EventGraph->AddNode(BeginPlayNode);
-					BeginPlayNode->EventReference.SetExternalMember(FName(TEXT("ReceiveBeginPlay")), AActor::StaticClass());
-					BeginPlayNode->bOverrideFunction = true;
-					BeginPlayNode->NodePosX = 0;
-					BeginPlayNode->NodePosY = 0;
-					BeginPlayNode->AllocateDefaultPins();
-
-					UE_LOG(LogTemp, Warning, TEXT("Created new Event BeginPlay node in Blueprint '%s'"), *Blueprint->GetName());
-				}
-
-				// Create a call function node to call the Logi_ThermalActorSetup function
-				UK2Node_CallFunction* CallSetupFunctionNode = Logi::BlueprintUtils::CreateBPCallFunctionNode(EventGraph, FName("Logi_ThermalActorSetup"), BeginPlayNode->NodePosX + 200, BeginPlayNode->NodePosY);
-
-				//find the BeginPlay node's then pin
-				UEdGraphPin* BeginPlayThenPin = BeginPlayNode->FindPin(UEdGraphSchema_K2::PN_Then);
-
-				//Check if there are nodes already connected to the BeginPlay node
-				if (BeginPlayThenPin) {
-					//Check if the BeginPlay node has any linked nodes, if so make connection between the call function node and the node connected to the BeginPlay node
-					if (BeginPlayThenPin->LinkedTo.Num() > 0) {
-						//Find the pin connected to the BeginPlay node
-						UEdGraphPin* OriginalConnectedPin = BeginPlayThenPin->LinkedTo[0];
+			UE_LOG(LogTemp, Warning, TEXT("Adding thermal component to actor: %s"), *Actor.AssetName.ToString());
 
-						//Break connection between begin play node and the node connected to it
-						Schema->BreakPinLinks(*BeginPlayThenPin, false);
-
-						//connect the BeginPlay node to the call function node
-						Schema->TryCreateConnection(CallSetupFunctionNode->GetThenPin(), OriginalConnectedPin);
-
-						//Connect BeginPlay node to the call function node
-						Schema->TryCreateConnection(BeginPlayThenPin, CallSetupFunctionNode->GetExecPin());
-
-					}
-					else {
-						Schema->TryCreateConnection(BeginPlayThenPin, CallSetupFunctionNode->GetExecPin());
-					}
-				}
-			}
-
-			// Create a call function node to call the Logi_UpdateThermalMaterial function
-			if (!bLogiUpdateThermalMaterialFunctionNodeAlreadyExists) {
+			AddThermalComponentToActorBlueprint(Actor);
+		}
+	}
 
-				// Find EventTick node
-				UK2Node_Event* EventTickNode = nullptr;
-				for (UEdGraphNode* Node : EventGraph->Nodes) {
-					UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-					if (EventNode && EventNode->EventReference.GetMemberName() == FName(TEXT("ReceiveTick"))) {
-						EventTickNode = EventNode;
-						break;
-					}
-				}
+	void MakeLevelNativeActorsLogiCompatible(UWorld* World) {
+		//Validate world
+		if (!World) {
+			UE_LOG(LogTemp, Error, TEXT("World is null, cannot add thermal components to level actors."));
+			return;
+		}
 
-				//if the event begin play node is not in the event graph, create it
-				if (!EventTickNode) {
-					// If not found, create the BeginPlay event node
-					EventTickNode = NewObject<UK2Node_Event>(EventGraph);
-					EventGraph->AddNode(EventTickNode);
-					EventTickNode->EventReference.SetExternalMember(FName(TEXT("ReceiveTick")), AActor::StaticClass());
-					EventTickNode->bOverrideFunction = true;
-					EventTickNode->NodePosX = 0;
-					EventTickNode->NodePosY = 0;
-					EventTickNode->AllocateDefaultPins();
-
-					UE_LOG(LogTemp, Warning, TEXT("Created new Event eventTickNode node in Blueprint '%s'"), *Blueprint->GetName());
-				}
+		//Native mesh actors are not blueprints, so they get the thermal component as an instance component.
+		//Only placed static and skeletal mesh actors are patched, other native actors with meshes (e.g. brushes, lights
+		//with editor meshes, gameplay actors spawned from code) are left alone.
+		for (TActorIterator<AActor> It(World); It; ++It) {
+			AActor* Actor = *It;
 
-				//find the eventTick node's then and value pin
-				UEdGraphPin* EventTickThenPin = EventTickNode->FindPin(UEdGraphSchema_K2::PN_Then);
-				UEdGraphPin* EventTickValuePin = EventTickNode->FindPin(FName("DeltaSeconds"));
+			//Skip blueprint actors, they get the thermal component through their blueprint
+			if (!Actor || Cast<UBlueprintGeneratedClass>(Actor->GetClass())) continue;
 
-				// Create a call function node to call the Logi_ThermalActorSetup function
-				UK2Node_CallFunction* CallUpdateThermalMaterialNode= Logi::BlueprintUtils::CreateBPCallFunctionNode(EventGraph, FName("Logi_UpdateThermalMaterial"), EventTickNode->NodePosX + 200, EventTickNode->NodePosY);
+			if (!Actor->IsA<AStaticMeshActor>() && !Actor->IsA<ASkeletalMeshActor>()) continue;
 
-				//Check if there are nodes already connected to the event tick node
-				if (EventTickThenPin) {
-					//Check if the event tick has any linked nodes, if so make connection between the call function node and the node connected to the event tick node
-					if (EventTickThenPin->LinkedTo.Num() > 0) {
-						//Find the pin connected to the BeginPlay node
-						UEdGraphPin* OriginalConnectedPin = EventTickThenPin->LinkedTo[0];
+			//Skip editor only actors, they are not in the game
+			if (Actor->IsEditorOnly()) continue;
 
-						//Break connection between begin play node and the node connected to it
-						Schema->BreakPinLinks(*EventTickThenPin, false);
+			//Skip actors that already are thermal actors
+			if (Actor->FindComponentByClass<UThermalComponent>()) continue;
 
-						//connect the BeginPlay node to the call function node
-						Schema->TryCreateConnection(CallUpdateThermalMaterialNode->GetThenPin(), OriginalConnectedPin);
+			//Add the thermal component to the actor instance
+			Actor->Modify();
+			UThermalComponent* ThermalComponent = NewObject<UThermalComponent>(Actor, FName("Logi_Thermal"), RF_Transactional);
+			Actor->AddInstanceComponent(ThermalComponent);
+			ThermalComponent->RegisterComponent();
 
-						//Connect beginplaynode to the call function node
-						Schema->TryCreateConnection(EventTickThenPin, CallUpdateThermalMaterialNode->GetExecPin());
-					}
-					else {
-						Schema->TryCreateConnection(EventTickThenPin, CallUpdateThermalMaterialNode->GetExecPin());
-					}
-				}
-			}
-			
+			UE_LOG(LogTemp, Log, TEXT("Thermal component successfully added to level actor '%s'."), *Actor->GetActorLabel());
 		}
 	}
 
@@ -1,21 +1,24 @@
 ﻿#pragma once
 #include "K2Node_FunctionEntry.h"
 
+class UThermalComponent;
+
 namespace Logi::ActorPatcher
 {
+	void CreateThermalMaterialAsset(const FString& MaterialName, const FString& FunctionPath, bool& bSuccess, FString& StatusMessage);
+
 	void CreateThermalMaterial(bool& bSuccess, FString& StatusMessage);
 
 	static void FindAllNonLogiActorBlueprintsInProject(TArray<FAssetData>& OutActorBlueprints);
 
-	static void AddLogiVariablesToActorBlueprint(const FAssetData& Actor);
+	static void AddThermalComponentToActorBlueprint(const FAssetData& Actor);
 
-	static void AddNodeSetupToSetupFunction(UEdGraph* FunctionGraph, const UK2Node_FunctionEntry* EntryNode);
+	static void CopyLegacyLogiVariablesToThermalComponent(const UBlueprint* Blueprint, UThermalComponent* ThermalComponent);
 
-	static void AddNodeSetupToUpdateThermalMaterialFunction(UEdGraph* FunctionGraph, const UK2Node_FunctionEntry* EntryNode);
+	static void RemoveLegacyLogiSetupFromBlueprint(UBlueprint* Blueprint);
 
-	static UEdGraph* AddSetupFunctionToNonLogiActor(const FAssetData& Actor);
-	
-	static UEdGraph* AddUpdateThermalMaterialFunctionToNonLogiActor(const FAssetData& Actor);
+	void MakeProjectBPActorsLogiCompatible();
 
-	static void MakeProjectBPActorsLogiCompatible();
+	// Adds a thermal component to the static and skeletal mesh actors placed in the level that are not blueprints
+	void MakeLevelNativeActorsLogiCompatible(UWorld* World);
 };
@@ -82,7 +82,7 @@ void FLogiModule::PluginButtonClicked()
 	//Show confirmation dialogue box when the plugin button is clicked
 	EAppReturnType::Type Result = FMessageDialog::Open(
 		EAppMsgType::YesNo,
-		FText::FromString(TEXT("The Logi plugin will alter you current prosject. New actors and a post process volume will be added to your scene and all actors inn your project will have additional variables and node setups created inside their blueprints. Are you sure you want to run the Logi plugin setup?"))
+		FText::FromString(TEXT("The Logi plugin will alter you current prosject. New actors and a post process volume will be added to your scene and all actors inn your project will have a thermal component added to them. Are you sure you want to run the Logi plugin setup?"))
 	);
 
 	//Cancel plugin if user clicks no
@@ -140,6 +140,9 @@ void FLogiModule::PluginButtonClicked()
 	//Make all project actors logi compatible
 	Logi::ActorPatcher::MakeProjectBPActorsLogiCompatible();
 
+	//Make all native actors placed in the level logi compatible
+	Logi::ActorPatcher::MakeLevelNativeActorsLogiCompatible(World);
+
 	Logi::LogiOutliner::AddLogiLogicToOutliner(World, bSuccess, StatusMessage);
 
 	//Log status
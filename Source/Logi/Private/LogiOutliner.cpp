@@ -210,6 +210,24 @@ namespace Logi::LogiOutliner
             UE_LOG(LogTemp, Error, TEXT("Failed to load PostProcessMaterial."));
         }
 
+        // Separable blur passes, only generated in the SeparableGaussian blur mode. Their blendable priority runs them before PP_Logi_ThermalCamera.
+        const TCHAR* BlurPassPaths[] = {
+            TEXT("/Game/Logi_ThermalCamera/Materials/PP_Logi_ThermalBlurH"),
+            TEXT("/Game/Logi_ThermalCamera/Materials/PP_Logi_ThermalBlurV")
+        };
+
+        for (const TCHAR* BlurPassPath : BlurPassPaths)
+        {
+            if (UMaterialInterface* BlurPassMaterial = LoadObject<UMaterialInterface>(nullptr, BlurPassPath, nullptr, LOAD_NoWarn | LOAD_Quiet))
+            {
+                FWeightedBlendable Blendable;
+                Blendable.Object = BlurPassMaterial;
+                Blendable.Weight = 1.0f;
+
+                NewVolume->Settings.WeightedBlendables.Array.Add(Blendable);
+            }
+        }
+
         const bool bSaved = LogiUtils::SaveAssetToDisk(NewVolume);
 
         if (bSaved)
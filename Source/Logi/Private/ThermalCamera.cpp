@@ -3,8 +3,11 @@
 #include <optional>
 
 #include "AssetToolsModule.h"
+#include "LogiSettings.h"
 #include "MaterialDomain.h"
+#include "ThermalPalettes.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "SceneTypes.h"
 
@@ -21,6 +24,7 @@
 #include "Materials/MaterialExpressionAppendVector.h"
 #include "Materials/MaterialExpressionClamp.h"
 #include "Materials/MaterialExpressionConstant2Vector.h"
+#include "Materials/MaterialExpressionCustom.h"
 #include "Materials/MaterialExpressionDivide.h"
 #include "Materials/MaterialExpressionFloor.h"
 #include "Materials/MaterialExpressionIf.h"
@@ -30,15 +34,219 @@
 #include "Materials/MaterialExpressionPower.h"
 #include "Materials/MaterialExpressionStep.h"
 #include "Materials/MaterialExpressionTextureCoordinate.h"
+#include "Materials/MaterialExpressionTextureObject.h"
 #include "Materials/MaterialExpressionTime.h"
-#include "Materials/MaterialExpressionVectorNoise.h"
 #include "Utils/EThermalSettingsParamType.h"
 #include "Utils/LogiUtils.h"
 #include "Utils/MaterialUtils.h"
 
 namespace Logi::ThermalCamera
 {
+    /* Separable Gaussian blur (EThermalBlurMode::SeparableGaussian) */
+
+    // SceneTextureLookup ids (ESceneTextureId): 14 is PostProcessInput0, 8 is WorldNormal
+    // Blur arrives as 0-1 from the controller's 0-100, full Blur is a radius of 32 pixels, which also caps the taps per side
+    // Every scene texture is stepped in its own UV space, PostProcessInput0 can be smaller than the scene buffers (screen percentage)
+
+    // Horizontal Gaussian pass - R: blurred thermal actor temperature, G: blurred facing ratio of the world normal
+    // (The world normal has no render target of its own between passes, so its only use, the background Fresnel, is packed instead)
+    static const TCHAR* ThermalBlurHorizontalCode = TEXT(
+        "const float Radius = saturate(Blur) * 32.0;\n"
+        "const int Taps = (int)ceil(Radius);\n"
+        "const float Sigma = max(Radius / 3.0, 0.3);\n"
+        "const float InvTwoSigmaSquared = 0.5 / (Sigma * Sigma);\n"
+        "const float2 UV = GetDefaultSceneTextureUV(Parameters, 14);\n"
+        "const float2 TexelStep = float2(GetSceneTextureViewSize(14).z, 0.0);\n"
+        "const float2 NormalUV = GetDefaultSceneTextureUV(Parameters, 8);\n"
+        "const float2 NormalTexelStep = float2(GetSceneTextureViewSize(8).z, 0.0);\n"
+        "float2 Sum = float2(PostProcessInput0.r, saturate(dot(WorldNormal.rgb, Parameters.CameraVector)));\n"
+        "float WeightSum = 1.0;\n"
+        "[loop]\n"
+        "for (int Tap = 1; Tap <= Taps; ++Tap)\n"
+        "{\n"
+        "    const float Weight = exp(-Tap * Tap * InvTwoSigmaSquared);\n"
+        "    const float2 Offset = TexelStep * Tap;\n"
+        "    const float2 NormalOffset = NormalTexelStep * Tap;\n"
+        "    const float TemperatureA = SceneTextureLookup(UV - Offset, 14, false).r;\n"
+        "    const float TemperatureB = SceneTextureLookup(UV + Offset, 14, false).r;\n"
+        "    const float FacingA = saturate(dot(SceneTextureLookup(NormalUV - NormalOffset, 8, false).rgb, Parameters.CameraVector));\n"
+        "    const float FacingB = saturate(dot(SceneTextureLookup(NormalUV + NormalOffset, 8, false).rgb, Parameters.CameraVector));\n"
+        "    Sum += Weight * float2(TemperatureA + TemperatureB, FacingA + FacingB);\n"
+        "    WeightSum += 2.0 * Weight;\n"
+        "}\n"
+        "return float3(Sum / WeightSum, 0.0);\n");
+
+    // Vertical Gaussian pass - blurs the R and G the horizontal pass packed
+    static const TCHAR* ThermalBlurVerticalCode = TEXT(
+        "const float Radius = saturate(Blur) * 32.0;\n"
+        "const int Taps = (int)ceil(Radius);\n"
+        "const float Sigma = max(Radius / 3.0, 0.3);\n"
+        "const float InvTwoSigmaSquared = 0.5 / (Sigma * Sigma);\n"
+        "const float2 UV = GetDefaultSceneTextureUV(Parameters, 14);\n"
+        "const float2 TexelStep = float2(0.0, GetSceneTextureViewSize(14).w);\n"
+        "float2 Sum = PostProcessInput0.rg;\n"
+        "float WeightSum = 1.0;\n"
+        "[loop]\n"
+        "for (int Tap = 1; Tap <= Taps; ++Tap)\n"
+        "{\n"
+        "    const float Weight = exp(-Tap * Tap * InvTwoSigmaSquared);\n"
+        "    const float2 Offset = TexelStep * Tap;\n"
+        "    Sum += Weight * (SceneTextureLookup(UV - Offset, 14, false).rg + SceneTextureLookup(UV + Offset, 14, false).rg);\n"
+        "    WeightSum += 2.0 * Weight;\n"
+        "}\n"
+        "return float3(Sum / WeightSum, 0.0);\n");
+
+    // Fresnel of the facing ratio packed by the blur passes, same as the Fresnel-node with its default base reflect fraction of 0.04
+    static const TCHAR* PackedFresnelCode = TEXT(
+        "return 0.04 + 0.96 * pow(max(1.0 - FacingRatio.g, 0.000001), Exponent);\n");
+
+    // Palette lookup - Palette 0 is the controller's Cold, Mid and Hot blend, every other value is a row of T_Logi_ThermalPalettes
+    // Palette comes from the MPC, so the branch is the same for every pixel and switching palettes never recompiles the material
+    static const TCHAR* ThermalPaletteCode = TEXT(
+        "const float Temperature = saturate(Alpha.x);\n"
+        "[branch]\n"
+        "if (Palette < 0.5)\n"
+        "{\n"
+        "    return lerp(lerp(Cold.rgb, Mid.rgb, saturate(Temperature * 2.0)), Hot.rgb, saturate(Temperature * 2.0 - 1.0));\n"
+        "}\n"
+        "const float2 UV = float2((Temperature * 255.0 + 0.5) / 256.0, (Palette - 0.5) / 4.0);\n"
+        "return Texture2DSampleLevel(Palettes, PalettesSampler, UV, 0.0).rgb;\n");
+
+    static_assert(ThermalPalettes::Width == 256 && ThermalPalettes::NumPalettes == 4, "ThermalPaletteCode expects a 256x4 palette atlas");
+
+    // Pixel grid of the sensor noise - the controller's SensorResolution, or the view size while it is 0
+    static const TCHAR* SensorSizeCode = TEXT(
+        "return SensorResolution.x > 0.0 && SensorResolution.y > 0.0 ? SensorResolution.xy : ViewSize;\n");
+
+    // Sensor noise of one noise cell - Position is the cell in xy and the noise frame in z
+    // NoiseMode 0 hashes the cell (PCG, the same hash as the thermal image extension), 1 tiles the blue noise texture and shifts it every frame
+    // NoiseAmount and NoiseMode come from the MPC, so both branches are the same for every pixel and nothing is computed while the amount is 0
+    static const TCHAR* SensorNoiseCode = TEXT(
+        "[branch]\n"
+        "if (NoiseAmount <= 0.0)\n"
+        "{\n"
+        "    return 0.0;\n"
+        "}\n"
+        "const uint3 Cell = uint3(floor(Position));\n"
+        "uint Hash = Cell.z;\n"
+        "[unroll]\n"
+        "for (int Round = 0; Round < 3; ++Round)\n"
+        "{\n"
+        "    const uint State = Hash * 747796405u + 2891336453u;\n"
+        "    const uint Word = ((State >> ((State >> 28u) + 4u)) ^ State) * 277803737u;\n"
+        "    Hash = (Word >> 22u) ^ Word;\n"
+        "    // The first round hashed the frame, blue noise only needs that for its tile offset\n"
+        "    [branch]\n"
+        "    if (Round == 0 && NoiseMode > 0.5)\n"
+        "    {\n"
+        "        uint Width, Height;\n"
+        "        BlueNoise.GetDimensions(Width, Height);\n"
+        "        const uint2 TilePos = (Cell.xy + uint2(Hash & 0xffffu, Hash >> 16u)) % uint2(Width, Height);\n"
+        "        return BlueNoise.Load(int3(TilePos, 0)).r;\n"
+        "    }\n"
+        "    Hash += Round == 0 ? Cell.y : Cell.x;\n"
+        "}\n"
+        "return Hash / 4294967295.0;\n");
     
+    static UTexture2D* CreateThermalPaletteTexture(FString& StatusMessage)
+    {
+        const FString AssetPath = TEXT("/Game/Logi_ThermalCamera/Materials/T_Logi_ThermalPalettes");
+
+        // An existing atlas is rewritten, so palette changes in ThermalPalettes reach projects that already have one
+        UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *AssetPath);
+        const bool bCreated = Texture == nullptr;
+
+        if (bCreated)
+        {
+            UPackage* Package = CreatePackage(*AssetPath);
+            Texture = NewObject<UTexture2D>(Package, FName("T_Logi_ThermalPalettes"), RF_Public | RF_Standalone);
+        }
+
+        if (!Texture)
+        {
+            StatusMessage = FString::Printf(TEXT("Could not create Texture: %s"), *AssetPath);
+            return nullptr;
+        }
+
+        // One row per palette
+        TArray<FColor> Colors;
+        Colors.SetNumUninitialized(ThermalPalettes::Width * ThermalPalettes::NumPalettes);
+
+        for (int32 Palette = 0; Palette < ThermalPalettes::NumPalettes; ++Palette)
+        {
+            ThermalPalettes::GetPaletteColors(Palette, TArrayView<FColor>(Colors.GetData() + Palette * ThermalPalettes::Width, ThermalPalettes::Width));
+        }
+
+        Texture->PreEditChange(nullptr);
+        Texture->Source.Init(ThermalPalettes::Width, ThermalPalettes::NumPalettes, 1, 1, TSF_BGRA8, reinterpret_cast<const uint8*>(Colors.GetData()));
+
+        // Uncompressed sRGB without mips, bilinear along a row and sampled at the row centers so rows never bleed into each other
+        Texture->SRGB = true;
+        Texture->CompressionSettings = TC_VectorDisplacementmap;
+        Texture->MipGenSettings = TMGS_NoMipmaps;
+        Texture->LODGroup = TEXTUREGROUP_ColorLookupTable;
+        Texture->Filter = TF_Bilinear;
+        Texture->AddressX = TA_Clamp;
+        Texture->AddressY = TA_Clamp;
+        Texture->NeverStream = true;
+
+        Texture->PostEditChange();
+        Texture->MarkPackageDirty();
+
+        if (bCreated)
+        {
+            FAssetRegistryModule::AssetCreated(Texture);
+        }
+
+        if (!LogiUtils::SaveAssetToDisk(Texture))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Texture %s created, but failed to save properly. Manual save required: %s"), *Texture->GetName(), *AssetPath);
+        }
+
+        return Texture;
+    }
+
+    static UMaterialExpressionCustom* CreatePaletteNodes(UMaterial* Material, TArray<TObjectPtr<UMaterialExpression>>& Expressions,
+                                                         const FVector2D& PaletteNodePos, UTexture2D* PaletteTexture)
+    {
+        // Custom-node - Palette lookup, the caller connects the temperature to Alpha
+        UMaterialExpressionCustom* PaletteNode = MaterialUtils::CreateCustomNode(Material, PaletteNodePos, TEXT("Thermal Palette"), ThermalPaletteCode, CMOT_Float3,
+            { TEXT("Alpha"), TEXT("Palette"), TEXT("Palettes"), TEXT("Cold"), TEXT("Mid"), TEXT("Hot") });
+        Expressions.Add(PaletteNode);
+
+        // MPC_ThermalSettings "Palette" node
+        const FVector2D ThermalSettingsPalettePos(PaletteNodePos.X - 400, PaletteNodePos.Y - 420);
+        UMaterialExpressionCollectionParameter* ThermalSettingsPaletteNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsPalettePos, TEXT("Palette"), EThermalSettingsParamType::Scalar);
+        Expressions.Add(ThermalSettingsPaletteNode);
+        PaletteNode->Inputs[1].Input.Connect(0, ThermalSettingsPaletteNode);
+
+        // TextureObject-node - T_Logi_ThermalPalettes
+        const FVector2D PaletteTextureNodePos(PaletteNodePos.X - 400, PaletteNodePos.Y - 340);
+        UMaterialExpressionTextureObject* PaletteTextureNode = MaterialUtils::CreateTextureObjectNode(Material, PaletteTextureNodePos, PaletteTexture);
+        Expressions.Add(PaletteTextureNode);
+        PaletteNode->Inputs[2].Input.Connect(0, PaletteTextureNode);
+
+        // MPC_ThermalSettings "Cold" node
+        const FVector2D ThermalSettingsColdPos(PaletteNodePos.X - 400, PaletteNodePos.Y - 120);
+        UMaterialExpressionCollectionParameter* ThermalSettingsColdNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsColdPos, TEXT("Cold"), EThermalSettingsParamType::Vector);
+        Expressions.Add(ThermalSettingsColdNode);
+        PaletteNode->Inputs[3].Input.Connect(0, ThermalSettingsColdNode);
+
+        // MPC_ThermalSettings "Mid" node
+        const FVector2D ThermalSettingsMidPos(PaletteNodePos.X - 400, PaletteNodePos.Y + 20);
+        UMaterialExpressionCollectionParameter* ThermalSettingsMidNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsMidPos, TEXT("Mid"), EThermalSettingsParamType::Vector);
+        Expressions.Add(ThermalSettingsMidNode);
+        PaletteNode->Inputs[4].Input.Connect(0, ThermalSettingsMidNode);
+
+        // MPC_ThermalSettings "Hot" node
+        const FVector2D ThermalSettingsHotPos(PaletteNodePos.X - 400, PaletteNodePos.Y + 160);
+        UMaterialExpressionCollectionParameter* ThermalSettingsHotNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsHotPos, TEXT("Hot"), EThermalSettingsParamType::Vector);
+        Expressions.Add(ThermalSettingsHotNode);
+        PaletteNode->Inputs[5].Input.Connect(0, ThermalSettingsHotNode);
+
+        return PaletteNode;
+    }
+
     static UMaterialExpressionLinearInterpolate* CreateNodeArea1(UMaterial* Material,
                                                                  TArray<TObjectPtr<UMaterialExpression>>& Expressions)
     {
@@ -88,7 +296,7 @@ namespace Logi::ThermalCamera
     };
 
     static FNodeArea2Result CreateNodeArea2(UMaterial* Material, TArray<TObjectPtr<UMaterialExpression>>& Expressions,
-                                            UMaterialExpressionLinearInterpolate* Area1WhiteLerpNode)
+                                            UMaterialExpressionLinearInterpolate* Area1WhiteLerpNode, UTexture2D* BlueNoiseTexture)
     {
         /* 2 - Yellow area  - Add noise */
 
@@ -132,19 +340,28 @@ namespace Logi::ThermalCamera
         UMaterialExpressionComment* CommentNoiseImageArea = MaterialUtils::CreateCommentNode(Material, CommentNoiseImageAreaPos, CommentNoiseImageAreaSize, CommentNoiseImageAreaText);
         Expressions.Add(CommentNoiseImageArea);
         
-        // Mask-node
-        const FVector2D NoiseMaskPos(-1550, 450);
-        UMaterialExpressionComponentMask* NoiseMaskNode = MaterialUtils::CreateMaskNode(Material, NoiseMaskPos, true, false, false);
-        Expressions.Add(NoiseMaskNode);
-        
-        Result.Area2YellowAddNode->B.Connect(0, NoiseMaskNode);
+        // Custom-node - Sensor noise, hash or blue noise picked by the MPC
+        const FVector2D SensorNoisePos(-1650, 450);
+        UMaterialExpressionCustom* SensorNoiseNode = MaterialUtils::CreateCustomNode(Material, SensorNoisePos, TEXT("Sensor Noise"), SensorNoiseCode, CMOT_Float1,
+            { TEXT("Position"), TEXT("NoiseAmount"), TEXT("NoiseMode"), TEXT("BlueNoise") });
+        Expressions.Add(SensorNoiseNode);
+
+        Result.Area2YellowAddNode->B.Connect(0, SensorNoiseNode);
+        SensorNoiseNode->Inputs[1].Input.Connect(0, ThermalSettingsNoiseAmountNode);
+
+        // ThermalSettingsNoiseMode-node
+        const FVector2D ThermalSettingsNoiseModePos(-1950, 720);
+        UMaterialExpressionCollectionParameter* ThermalSettingsNoiseModeNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsNoiseModePos, TEXT("NoiseMode"), EThermalSettingsParamType::Scalar);
+        Expressions.Add(ThermalSettingsNoiseModeNode);
+
+        SensorNoiseNode->Inputs[2].Input.Connect(0, ThermalSettingsNoiseModeNode);
 
-        // VectorNoise-node
-        const FVector2D VectorNoisePos(-1750, 450);
-        UMaterialExpressionVectorNoise* VectorNoiseNode = MaterialUtils::CreateVectorNoiseNode(Material, VectorNoisePos);
-        Expressions.Add(VectorNoiseNode);
+        // TextureObject-node - ULogiSettings::BlueNoiseTexture
+        const FVector2D BlueNoiseTexturePos(-1950, 800);
+        UMaterialExpressionTextureObject* BlueNoiseTextureNode = MaterialUtils::CreateTextureObjectNode(Material, BlueNoiseTexturePos, BlueNoiseTexture);
+        Expressions.Add(BlueNoiseTextureNode);
 
-        NoiseMaskNode->Input.Connect(0, VectorNoiseNode);
+        SensorNoiseNode->Inputs[3].Input.Connect(0, BlueNoiseTextureNode);
 
 
         /*** Convert vector 2 to vector 3 ***/
@@ -154,8 +371,8 @@ namespace Logi::ThermalCamera
         UMaterialExpressionAppendVector* AppendVectorNode = MaterialUtils::CreateAppendVectorNode(Material, AppendVectorPos);
         Expressions.Add(AppendVectorNode);
 
-        // Connect AppendVector to VectorNoise
-        VectorNoiseNode->Position.Connect(0, AppendVectorNode);
+        // Connect AppendVector to Sensor Noise
+        SensorNoiseNode->Inputs[0].Input.Connect(0, AppendVectorNode);
 
 
         // Multiply-node
@@ -262,7 +479,22 @@ namespace Logi::ThermalCamera
         Expressions.Add(CoordinatesViewSizeNode);
 
         CoordinatesViewSizeNode->UpdateFromFunctionResource();
-        CoordinatesMultiplyNode->B.Connect(0, CoordinatesViewSizeNode);
+
+        // Custom-node - Sensor size
+        const FVector2D CoordinatesSensorSizeNodePos(-3400, 600);
+        UMaterialExpressionCustom* CoordinatesSensorSizeNode = MaterialUtils::CreateCustomNode(Material, CoordinatesSensorSizeNodePos, TEXT("Sensor Size"), SensorSizeCode, CMOT_Float2, { TEXT("ViewSize"), TEXT("SensorResolution") });
+        Expressions.Add(CoordinatesSensorSizeNode);
+
+        CoordinatesSensorSizeNode->Inputs[0].Input.Connect(0, CoordinatesViewSizeNode);
+        CoordinatesMultiplyNode->B.Connect(0, CoordinatesSensorSizeNode);
+
+        // MPC_ThermalSettings node
+        const FVector2D ThermalSettingsSensorResolutionPos(-3620, 720);
+        UMaterialExpressionCollectionParameter* ThermalSettingsSensorResolutionNode = MaterialUtils::CreateThermalSettingsCPNode(
+            Material, ThermalSettingsSensorResolutionPos, TEXT("SensorResolution"), EThermalSettingsParamType::Vector);
+        Expressions.Add(ThermalSettingsSensorResolutionNode);
+
+        CoordinatesSensorSizeNode->Inputs[1].Input.Connect(0, ThermalSettingsSensorResolutionNode);
 
         return Result;
     }
@@ -298,12 +530,14 @@ namespace Logi::ThermalCamera
 
     struct FNodeArea4Result
     {
-        UMaterialExpressionMaterialFunctionCall* Area4Background3ColorBlendNode = nullptr;
+        UMaterialExpressionCustom* Area4BackgroundPaletteNode = nullptr;
         UMaterialExpressionMultiply* Area4AddSkyMultiplyNode = nullptr;
     };
 
     static FNodeArea4Result CreateNodeArea4(UMaterial* Material,
-                                            TArray<TObjectPtr<UMaterialExpression>>& Expressions)
+                                            TArray<TObjectPtr<UMaterialExpression>>& Expressions,
+                                            const EThermalBlurMode BlurMode,
+                                            UTexture2D* PaletteTexture)
     {
         /* 4 - Blue area */
 
@@ -318,55 +552,9 @@ namespace Logi::ThermalCamera
         Expressions.Add(BackgroundComment);
 
 
-        // 3ColorBlend-node
-        const FVector2D Background3ColorBlendNodePos(-5900, -2150);
-        UMaterialExpressionMaterialFunctionCall* Background3ColorBlendNode = MaterialUtils::Create3ColorBlendNode(Material, Background3ColorBlendNodePos);
-        Expressions.Add(Background3ColorBlendNode);
-
-        Background3ColorBlendNode->UpdateFromFunctionResource();
-        
-
-
-        // MPC_ThermalSettings "Cold" node
-        const FVector2D ThermalSettingsColdPos(-6400, -2500);
-        UMaterialExpressionCollectionParameter* ThermalSettingsColdNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsColdPos, TEXT("Cold"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalSettingsColdNode);
-        
-        for (FFunctionExpressionInput& Input : Background3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("A"))
-            {
-                Input.Input.Connect(0, ThermalSettingsColdNode);
-            }
-        }
-
-        // MPC_ThermalSettings "Mid" node
-        const FVector2D ThermalSettingsMidPos(-6400, -2300);
-        UMaterialExpressionCollectionParameter* ThermalSettingsMidNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsMidPos, TEXT("Mid"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalSettingsMidNode);
-        
-        for (FFunctionExpressionInput& Input : Background3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("B"))
-            {
-                Input.Input.Connect(0, ThermalSettingsMidNode);
-            }
-            
-        }
-
-        // MPC_ThermalSettings "Hot" node
-        const FVector2D ThermalSettingsHotPos(-6400, -2100);
-        UMaterialExpressionCollectionParameter* ThermalSettingsHotNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsHotPos, TEXT("Hot"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalSettingsHotNode);
-        
-        for (FFunctionExpressionInput& Input : Background3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("C"))
-            {
-                Input.Input.Connect(0, ThermalSettingsHotNode);
-            }
-            
-        }
+        // Palette-nodes
+        const FVector2D BackgroundPaletteNodePos(-5900, -2150);
+        UMaterialExpressionCustom* BackgroundPaletteNode = CreatePaletteNodes(Material, Expressions, BackgroundPaletteNodePos, PaletteTexture);
 
 
         // Multiply-node
@@ -388,26 +576,47 @@ namespace Logi::ThermalCamera
         BackgroundMultiplyNode->B.Connect(0, BackgroundOneMinusNode);
 
 
-        // Fresnel-node
-        const FVector2D BackgroundFresnelNodePos(-7400, -1700);
-        UMaterialExpressionFresnel* BackgroundFresnelNode = MaterialUtils::CreateFresnelNode(Material, BackgroundFresnelNodePos);
-        Expressions.Add(BackgroundFresnelNode);
-
-        BackgroundOneMinusNode->Input.Connect(0, BackgroundFresnelNode);
-
-
         // Fersnel EXP ScalarParameter-node
         const FVector2D BackgroundFresnelExpPos(-7700, -1715);
         UMaterialExpressionScalarParameter* BackgroundFresnelExpNode = MaterialUtils::CreateScalarParameterNode(Material, BackgroundFresnelExpPos, TEXT("Fersnel EXP"), 1.0f);
         Expressions.Add(BackgroundFresnelExpNode);
-        BackgroundFresnelNode->ExponentIn.Connect(0, BackgroundFresnelExpNode);
 
+        UMaterialExpressionComponentMask* BackgroundMaskNode = nullptr;
+
+        if (BlurMode == EThermalBlurMode::SeparableGaussian)
+        {
+            // Custom-node - Fresnel of the facing ratio the blur passes packed in G
+            const FVector2D BackgroundPackedFresnelNodePos(-7400, -1700);
+            UMaterialExpressionCustom* BackgroundPackedFresnelNode = MaterialUtils::CreateCustomNode(Material, BackgroundPackedFresnelNodePos, TEXT("Packed Fresnel"), PackedFresnelCode, CMOT_Float1, { TEXT("FacingRatio"), TEXT("Exponent") });
+            Expressions.Add(BackgroundPackedFresnelNode);
+
+            BackgroundOneMinusNode->Input.Connect(0, BackgroundPackedFresnelNode);
+            BackgroundPackedFresnelNode->Inputs[1].Input.Connect(0, BackgroundFresnelExpNode);
+
+            // SceneTexture:PostProcessInput0-node
+            const FVector2D BackgroundPostProcessInput0NodePos(-7750, -1620);
+            UMaterialExpressionMaterialFunctionCall* BackgroundPostProcessInput0Node = MaterialUtils::CreateSceneTexturePostProcessNode(Material, BackgroundPostProcessInput0NodePos);
+            Expressions.Add(BackgroundPostProcessInput0Node);
+            BackgroundPostProcessInput0Node->UpdateFromFunctionResource();
+            BackgroundPackedFresnelNode->Inputs[0].Input.Connect(0, BackgroundPostProcessInput0Node);
+        }
+        else
+        {
+            // Fresnel-node
+            const FVector2D BackgroundFresnelNodePos(-7400, -1700);
+            UMaterialExpressionFresnel* BackgroundFresnelNode = MaterialUtils::CreateFresnelNode(Material, BackgroundFresnelNodePos);
+            Expressions.Add(BackgroundFresnelNode);
+
+            BackgroundOneMinusNode->Input.Connect(0, BackgroundFresnelNode);
+            BackgroundFresnelNode->ExponentIn.Connect(0, BackgroundFresnelExpNode);
 
-        // Mask-node
-        const FVector2D BackgroundMaskNodePos(-7700, -1620);
-        UMaterialExpressionComponentMask* BackgroundMaskNode = MaterialUtils::CreateMaskNode(Material, BackgroundMaskNodePos, true, true, true);
-        Expressions.Add(BackgroundMaskNode);
-        BackgroundFresnelNode->Normal.Connect(0, BackgroundMaskNode);
+
+            // Mask-node
+            const FVector2D BackgroundMaskNodePos(-7700, -1620);
+            BackgroundMaskNode = MaterialUtils::CreateMaskNode(Material, BackgroundMaskNodePos, true, true, true);
+            Expressions.Add(BackgroundMaskNode);
+            BackgroundFresnelNode->Normal.Connect(0, BackgroundMaskNode);
+        }
 
         
 
@@ -428,14 +637,7 @@ namespace Logi::ThermalCamera
         Expressions.Add(AddSkyLerpNode);
 
         
-        for (FFunctionExpressionInput& Input : Background3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("Alpha"))
-            {
-                Input.Input.Connect(0, AddSkyLerpNode);
-            }
-            
-        }
+        BackgroundPaletteNode->Inputs[0].Input.Connect(0, AddSkyLerpNode);
 
         AddSkyLerpNode->B.Connect(0, BackgroundMultiplyNode);
 
@@ -524,6 +726,18 @@ namespace Logi::ThermalCamera
         ReAddSkyMaskBNode->Input.Connect(0, SceneTextureBaseColorNode);
 
 
+        FNodeArea4Result Result; 
+
+        Result.Area4BackgroundPaletteNode = BackgroundPaletteNode;
+        Result.Area4AddSkyMultiplyNode = AddSkyMultiplyNode;
+
+        // The separable blur already ran in the PP_Logi_ThermalBlur passes before this material
+        if (BlurMode == EThermalBlurMode::SeparableGaussian)
+        {
+            return Result;
+        }
+
+
         /** Blue 4.3 - World Normal blur control **/
 
         // Blue comment box (4.3) - World Normal blur control
@@ -969,23 +1183,21 @@ namespace Logi::ThermalCamera
         PixelSizeScreenResolutionNode->UpdateFromFunctionResource();
         PixelSizeDivideNode->B.Connect(0, PixelSizeScreenResolutionNode);
 
-
-        FNodeArea4Result Result; 
-
-        Result.Area4Background3ColorBlendNode = Background3ColorBlendNode;
-        Result.Area4AddSkyMultiplyNode = AddSkyMultiplyNode;
         
         return Result;
     }
 
     struct FNodeArea5Result
     {
-        UMaterialExpressionMaterialFunctionCall* Area5ThermalActor3ColorBlendNode = nullptr;
-        UMaterialExpressionLinearInterpolate* Area5GreenBlurLerpNode = nullptr;
+        UMaterialExpressionCustom* Area5ThermalActorPaletteNode = nullptr;
+        // Blurred PostProcessInput0, a Lerp-node in the legacy blur mode
+        UMaterialExpression* Area5GreenBlurNode = nullptr;
     };
 
     static FNodeArea5Result CreateNodeArea5(UMaterial* Material,
-                                            TArray<TObjectPtr<UMaterialExpression>>& Expressions)
+                                            TArray<TObjectPtr<UMaterialExpression>>& Expressions,
+                                            const EThermalBlurMode BlurMode,
+                                            UTexture2D* PaletteTexture)
     {
         FNodeArea5Result Result;
        
@@ -1002,54 +1214,9 @@ namespace Logi::ThermalCamera
         Expressions.Add(ThermalActorComment);
         
 
-        // 3ColorBlend-node
-        const FVector2D ThermalActor3ColorBlendNodePos(-6500, 240);
-        UMaterialExpressionMaterialFunctionCall* ThermalActor3ColorBlendNode = MaterialUtils::Create3ColorBlendNode(Material, ThermalActor3ColorBlendNodePos);
-        Expressions.Add(ThermalActor3ColorBlendNode);
-
-        ThermalActor3ColorBlendNode->UpdateFromFunctionResource();
-        
-
-        // MPC_ThermalSettings "Cold" node -6500, 180
-        const FVector2D ThermalActorThermalSettingsColdPos(-6800, -80);
-        UMaterialExpressionCollectionParameter* ThermalActorThermalSettingsColdNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalActorThermalSettingsColdPos, TEXT("Cold"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalActorThermalSettingsColdNode);
-        
-        for (FFunctionExpressionInput& Input : ThermalActor3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("A"))
-            {
-                Input.Input.Connect(0, ThermalActorThermalSettingsColdNode);
-            }
-        }
-
-        // MPC_ThermalSettings "Mid" node
-        const FVector2D ThermalActorThermalSettingsMidPos(-6800, 120);
-        UMaterialExpressionCollectionParameter* ThermalActorThermalSettingsMidNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalActorThermalSettingsMidPos, TEXT("Mid"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalActorThermalSettingsMidNode);
-        
-        for (FFunctionExpressionInput& Input : ThermalActor3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("B"))
-            {
-                Input.Input.Connect(0, ThermalActorThermalSettingsMidNode);
-            }
-            
-        }
-
-        // MPC_ThermalSettings "Hot" node
-        const FVector2D ThermalActorThermalSettingsHotPos(-6800, 320);
-        UMaterialExpressionCollectionParameter* ThermalActorThermalSettingsHotNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalActorThermalSettingsHotPos, TEXT("Hot"), EThermalSettingsParamType::Vector);
-        Expressions.Add(ThermalActorThermalSettingsHotNode);
-        
-        for (FFunctionExpressionInput& Input : ThermalActor3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("C"))
-            {
-                Input.Input.Connect(0, ThermalActorThermalSettingsHotNode);
-            }
-            
-        }
+        // Palette-nodes
+        const FVector2D ThermalActorPaletteNodePos(-6500, 240);
+        UMaterialExpressionCustom* ThermalActorPaletteNode = CreatePaletteNodes(Material, Expressions, ThermalActorPaletteNodePos, PaletteTexture);
 
 
         // Power-node
@@ -1057,13 +1224,7 @@ namespace Logi::ThermalCamera
         UMaterialExpressionPower* ThermalActorPowerNode = MaterialUtils::CreatePowerNode(Material, ThermalActorPowerNodePos);
         Expressions.Add(ThermalActorPowerNode);
         
-        for (FFunctionExpressionInput& Input : ThermalActor3ColorBlendNode->FunctionInputs)
-        {
-            if (Input.Input.InputName == TEXT("Alpha"))
-            {
-                Input.Input.Connect(0, ThermalActorPowerNode);
-            }
-        }
+        ThermalActorPaletteNode->Inputs[0].Input.Connect(0, ThermalActorPowerNode);
 
         // Mask-node
         const FVector2D ThermalActorMaskNodePos(-6900, 580);
@@ -1080,8 +1241,26 @@ namespace Logi::ThermalCamera
 
 
         
+        Result.Area5ThermalActorPaletteNode = ThermalActorPaletteNode;
+
+
         /** Green 5.2 - PostProcessInput0 blur control **/
 
+        // SceneTexture:PostProcessInput0-node
+        const FVector2D SceneTexturePostProcessInput0NodePos(-8400, -50);
+        UMaterialExpressionMaterialFunctionCall* SceneTexturePostProcessInput0Node = MaterialUtils::CreateSceneTexturePostProcessNode(Material, SceneTexturePostProcessInput0NodePos);
+        Expressions.Add(SceneTexturePostProcessInput0Node);
+        SceneTexturePostProcessInput0Node->UpdateFromFunctionResource();
+
+        // The separable blur already ran in the PP_Logi_ThermalBlur passes before this material
+        if (BlurMode == EThermalBlurMode::SeparableGaussian)
+        {
+            ThermalActorMaskNode->Input.Connect(0, SceneTexturePostProcessInput0Node);
+            Result.Area5GreenBlurNode = SceneTexturePostProcessInput0Node;
+
+            return Result;
+        }
+
         // Green comment box (5.2) - PostProcessInput0 blur control
         const FVector2D GreenBlurCommentPos(-8550, -150);
         const FVector2D GreenBlurCommentSize(700, 550);
@@ -1096,13 +1275,6 @@ namespace Logi::ThermalCamera
         UMaterialExpressionLinearInterpolate* GreenBlurLerpNode = MaterialUtils::CreateLerpNode(Material, GreenBlurLerpNodePos);
         Expressions.Add(GreenBlurLerpNode);
         ThermalActorMaskNode->Input.Connect(0, GreenBlurLerpNode);
-        
-
-        // SceneTexture:PostProcessInput0-node
-        const FVector2D SceneTexturePostProcessInput0NodePos(-8400, -50);
-        UMaterialExpressionMaterialFunctionCall* SceneTexturePostProcessInput0Node = MaterialUtils::CreateSceneTexturePostProcessNode(Material, SceneTexturePostProcessInput0NodePos);
-        Expressions.Add(SceneTexturePostProcessInput0Node);
-        SceneTexturePostProcessInput0Node->UpdateFromFunctionResource();
         GreenBlurLerpNode->A.Connect(0, SceneTexturePostProcessInput0Node);
 
 
@@ -1526,8 +1698,7 @@ namespace Logi::ThermalCamera
 
        
 
-        Result.Area5ThermalActor3ColorBlendNode = ThermalActor3ColorBlendNode;
-        Result.Area5GreenBlurLerpNode = GreenBlurLerpNode;
+        Result.Area5GreenBlurNode = GreenBlurLerpNode;
 
         return Result;
     }
@@ -1628,8 +1799,132 @@ namespace Logi::ThermalCamera
         return HeatMaskIfNode;
     }
 
+    // One direction of the separable Gaussian blur as its own post process material
+    static bool CreateThermalBlurPass(const FString& AssetName, const bool bVertical, const int32 BlendablePriority, FString& StatusMessage)
+    {
+        const FString AssetPath = "/Game/Logi_ThermalCamera/Materials";
+        const FString FullAssetPath = AssetPath / AssetName;
+
+        const FAssetToolsModule& AssetToolsModule = FModuleManager::GetModuleChecked<FAssetToolsModule>("AssetTools");
+
+        UMaterialFactoryNew* Factory = NewObject<UMaterialFactoryNew>();
+        UMaterial* Material = Cast<UMaterial>(AssetToolsModule.Get().CreateAsset(AssetName, AssetPath, UMaterial::StaticClass(), Factory));
+
+        if (!Material)
+        {
+            StatusMessage = FString::Printf(TEXT("Could not create Material: %s"), *FullAssetPath);
+            return false;
+        }
+
+        // Post process materials at the same blendable location run in order of their priority, lowest first
+        Material->MaterialDomain = MD_PostProcess;
+        Material->BlendablePriority = BlendablePriority;
+
+        Material->PreEditChange(nullptr);
+        Material->Modify();
+
+        TArray<TObjectPtr<UMaterialExpression>>& Expressions = Material->GetExpressionCollection().Expressions;
+
+        // Comment box - Separable Gaussian blur
+        const FVector2D BlurCommentPos(-1300, 0);
+        const FVector2D BlurCommentSize(1250, 600);
+        const FString BlurCommentText = bVertical ? TEXT("Vertical Gaussian blur") : TEXT("Horizontal Gaussian blur, packs temperature in R and facing ratio in G");
+        UMaterialExpressionComment* BlurComment = MaterialUtils::CreateCommentNode(Material, BlurCommentPos, BlurCommentSize, BlurCommentText);
+        Expressions.Add(BlurComment);
+
+        // Lerp-node - Pass the image through untouched while the thermal camera is off
+        const FVector2D BlurLerpNodePos(-300, 200);
+        UMaterialExpressionLinearInterpolate* BlurLerpNode = MaterialUtils::CreateLerpNode(Material, BlurLerpNodePos);
+        Expressions.Add(BlurLerpNode);
+        Material->GetEditorOnlyData()->EmissiveColor.Connect(0, BlurLerpNode);
+
+        // ThermalSettingsCameraToggle-node
+        const FVector2D BlurCameraToggleNodePos(-600, 400);
+        UMaterialExpressionCollectionParameter* BlurCameraToggleNode = MaterialUtils::CreateThermalSettingsCPNode(Material, BlurCameraToggleNodePos, TEXT("ThermalCameraToggle"), EThermalSettingsParamType::Scalar);
+        Expressions.Add(BlurCameraToggleNode);
+        BlurLerpNode->Alpha.Connect(0, BlurCameraToggleNode);
+
+        // Custom-node - The inputs are the center tap, the other taps are read with SceneTextureLookup
+        TArray<FName> BlurInputNames = { TEXT("Blur"), TEXT("PostProcessInput0") };
+        if (!bVertical)
+        {
+            BlurInputNames.Add(TEXT("WorldNormal"));
+        }
+
+        const FVector2D BlurCustomNodePos(-600, 200);
+        UMaterialExpressionCustom* BlurCustomNode = MaterialUtils::CreateCustomNode(Material, BlurCustomNodePos, AssetName, bVertical ? ThermalBlurVerticalCode : ThermalBlurHorizontalCode, CMOT_Float3, BlurInputNames);
+        Expressions.Add(BlurCustomNode);
+        BlurLerpNode->B.Connect(0, BlurCustomNode);
+
+        // ThermalSettingsBlur-node
+        const FVector2D ThermalSettingsBlurNodePos(-1000, 100);
+        UMaterialExpressionCollectionParameter* ThermalSettingsBlurNode = MaterialUtils::CreateThermalSettingsCPNode(Material, ThermalSettingsBlurNodePos, TEXT("Blur"), EThermalSettingsParamType::Scalar);
+        Expressions.Add(ThermalSettingsBlurNode);
+        BlurCustomNode->Inputs[0].Input.Connect(0, ThermalSettingsBlurNode);
+
+        // SceneTexture:PostProcessInput0-node
+        const FVector2D BlurPostProcessInput0NodePos(-1000, 250);
+        UMaterialExpressionMaterialFunctionCall* BlurPostProcessInput0Node = MaterialUtils::CreateSceneTexturePostProcessNode(Material, BlurPostProcessInput0NodePos);
+        Expressions.Add(BlurPostProcessInput0Node);
+        BlurPostProcessInput0Node->UpdateFromFunctionResource();
+        BlurCustomNode->Inputs[1].Input.Connect(0, BlurPostProcessInput0Node);
+        BlurLerpNode->A.Connect(0, BlurPostProcessInput0Node);
+
+        if (!bVertical)
+        {
+            // SceneTexture:WorldNormal-node
+            const FVector2D BlurWorldNormalNodePos(-1000, 400);
+            UMaterialExpressionMaterialFunctionCall* BlurWorldNormalNode = MaterialUtils::CreateSceneTextureWorldNormalNode(Material, BlurWorldNormalNodePos);
+            Expressions.Add(BlurWorldNormalNode);
+            BlurWorldNormalNode->UpdateFromFunctionResource();
+            BlurCustomNode->Inputs[2].Input.Connect(0, BlurWorldNormalNode);
+        }
+
+        Material->PostEditChange();
+        Material->MarkPackageDirty();
+
+        FAssetRegistryModule::AssetCreated(Material);
+
+        if (!LogiUtils::SaveAssetToDisk(Material))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Material %s created, but failed to save properly. Manual save required: %s"), *Material->GetName(), *FullAssetPath);
+        }
+
+        return true;
+    }
+
     void CreateThermalCamera(bool& bSuccess, FString& StatusMessage)
     {
+        const EThermalBlurMode BlurMode = GetDefault<ULogiSettings>()->ThermalBlurMode;
+
+        // The blur passes run before PP_Logi_ThermalCamera, which keeps the default blendable priority of 0
+        if (BlurMode == EThermalBlurMode::SeparableGaussian)
+        {
+            if (!CreateThermalBlurPass(TEXT("PP_Logi_ThermalBlurH"), false, -2, StatusMessage)
+                || !CreateThermalBlurPass(TEXT("PP_Logi_ThermalBlurV"), true, -1, StatusMessage))
+            {
+                bSuccess = false;
+                return;
+            }
+        }
+
+        // Every palette is a row of one atlas, the material picks the row from the MPC
+        UTexture2D* PaletteTexture = CreateThermalPaletteTexture(StatusMessage);
+        if (!PaletteTexture)
+        {
+            bSuccess = false;
+            return;
+        }
+
+        // Sampled by the BlueNoise sensor noise mode
+        UTexture2D* BlueNoiseTexture = GetDefault<ULogiSettings>()->BlueNoiseTexture.LoadSynchronous();
+        if (!BlueNoiseTexture)
+        {
+            StatusMessage = FString::Printf(TEXT("Could not load blue noise Texture: %s"), *GetDefault<ULogiSettings>()->BlueNoiseTexture.ToString());
+            UE_LOG(LogTemp, Error, TEXT("%s"), *StatusMessage);
+            bSuccess = false;
+            return;
+        }
 
         const FString AssetPath = "/Game/Logi_ThermalCamera/Materials";
         const FString AssetName = "PP_Logi_ThermalCamera";
@@ -1675,7 +1970,7 @@ namespace Logi::ThermalCamera
         UMaterialExpressionLinearInterpolate* Area1WhiteLerpNode = CreateNodeArea1(Material, Expressions);
 
         // Area 2 - Yellow area - Add noise
-        const FNodeArea2Result Area2 = CreateNodeArea2(Material, Expressions, Area1WhiteLerpNode);
+        const FNodeArea2Result Area2 = CreateNodeArea2(Material, Expressions, Area1WhiteLerpNode, BlueNoiseTexture);
         
         // (Connects Area 1 to Area 2)
         Area1WhiteLerpNode->B.Connect(0, Area2.Area2YellowLerpNode);
@@ -1700,19 +1995,19 @@ namespace Logi::ThermalCamera
         Area3AppendNode->A.Connect(0, CombiningLerpNode);
 
         // Area 4 - Blue area
-        const FNodeArea4Result Area4 = CreateNodeArea4(Material, Expressions);
+        const FNodeArea4Result Area4 = CreateNodeArea4(Material, Expressions, BlurMode, PaletteTexture);
 
         // (Connect Area4 to CombiningLerpNode)
-        CombiningLerpNode->A.Connect(0, Area4.Area4Background3ColorBlendNode);
+        CombiningLerpNode->A.Connect(0, Area4.Area4BackgroundPaletteNode);
 
         // Area 5 - Green area
-        const FNodeArea5Result Area5 = CreateNodeArea5(Material, Expressions);
+        const FNodeArea5Result Area5 = CreateNodeArea5(Material, Expressions, BlurMode, PaletteTexture);
 
         // (Connects Area5 to CombiningLerpNode)
-        CombiningLerpNode->B.Connect(0, Area5.Area5ThermalActor3ColorBlendNode);
+        CombiningLerpNode->B.Connect(0, Area5.Area5ThermalActorPaletteNode);
 
-        // (Connects Area5's GreenBlurLerpNode node to Area4's AddSkypMultiply)
-        Area4.Area4AddSkyMultiplyNode->B.Connect(0,Area5.Area5GreenBlurLerpNode);
+        // (Connects Area5's blurred PostProcessInput0 to Area4's AddSkypMultiply)
+        Area4.Area4AddSkyMultiplyNode->B.Connect(0,Area5.Area5GreenBlurNode);
 
         // Area 6 - Orange area
         UMaterialExpressionIf* Area6HeatMaskIfNode = CreateNodeArea6(Material, Expressions);
@@ -8,9 +8,15 @@
 #include "Factories/MaterialFunctionFactoryNew.h"
 #include "Materials/MaterialExpressionLinearInterpolate.h"
 #include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "Materials/MaterialExpressionDotProduct.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionMultiply.h"
+#include "Materials/MaterialExpressionCollectionParameter.h"
 #include "Materials/MaterialExpressionFresnel.h"
 #include "Materials/MaterialExpressionPixelNormalWS.h"
 #include "Materials/MaterialExpressionComponentMask.h"
+#include "LogiSettings.h"
 #include "Utils/LogiUtils.h"
 #include "Utils/MaterialUtils.h"
 
@@ -18,10 +24,9 @@
 namespace Logi::ThermalMaterialFunction
 {
     
-    void CreateMaterialFunction(bool& bSuccess, FString& StatusMessage)
+    void CreateMaterialFunctionAsset(const FString& AssetName, const EThermalTemperatureSource TemperatureSource, bool& bSuccess, FString& StatusMessage)
     {
         const FString AssetPath = "/Game/Logi_ThermalCamera/Materials";
-        const FString AssetName = "MF_Logi_ThermalMaterialFunction";
 
         const FString FullAssetPath = AssetPath / AssetName;
 
@@ -41,6 +46,8 @@ namespace Logi::ThermalMaterialFunction
         {
             // Error log if MaterialFunction == nullptr
             UE_LOG(LogTemp, Error, TEXT("Could not create Material Function: %s"), *FullAssetPath);
+            bSuccess = false;
+            StatusMessage = FString::Printf(TEXT("Could not create Material Function: %s"), *FullAssetPath);
             return;
         }
 
@@ -76,20 +83,98 @@ namespace Logi::ThermalMaterialFunction
 
         EmissiveColor3ColorBlendNode->UpdateFromFunctionResource();
 
-        // Create BaseTemperature-node (3ColorBlend A input)
+        // Temperature nodes (3ColorBlend A, B and C inputs)
         const FVector2D NodeBaseTemperaturePos(-850, 0);
-        UMaterialExpressionScalarParameter* NodeBaseTemperature = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeBaseTemperaturePos, "BaseTemperature", 0.0f);
-        Expressions.Add(NodeBaseTemperature);
-
-        
-        // Create CurrentTemperature-node (3ColorBlend B input)
         const FVector2D NodeCurrentTemperaturePos(-850, 250);
-        UMaterialExpressionScalarParameter* NodeCurrentTemperature = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeCurrentTemperaturePos, "CurrentTemperature", 0.5f);
-        Expressions.Add(NodeCurrentTemperature);
-
-        // Create MaxTemperature-node (3ColorBlend C input)
         const FVector2D NodeMaxTemperaturePos(-850, 500);
-        UMaterialExpressionScalarParameter* NodeMaxTemperature = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeMaxTemperaturePos, "MaxTemperature", 1.0f);
+
+        UMaterialExpression* NodeBaseTemperature = nullptr;
+        UMaterialExpression* NodeCurrentTemperature = nullptr;
+        UMaterialExpression* NodeMaxTemperature = nullptr;
+
+        if (TemperatureSource == EThermalTemperatureSource::PerInstanceCustomData)
+        {
+            // Every instance of an instanced static mesh reads its own temperatures, the whole component stays one draw call
+            NodeBaseTemperature = MaterialUtils::CreatePerInstanceCustomDataNode(MaterialFunction, NodeBaseTemperaturePos, ThermalPrimitiveData::BaseTemperature, 0.0f);
+            NodeCurrentTemperature = MaterialUtils::CreatePerInstanceCustomDataNode(MaterialFunction, NodeCurrentTemperaturePos, ThermalPrimitiveData::CurrentTemperature, 0.5f);
+            NodeMaxTemperature = MaterialUtils::CreatePerInstanceCustomDataNode(MaterialFunction, NodeMaxTemperaturePos, ThermalPrimitiveData::MaxTemperature, 1.0f);
+        }
+        else if (TemperatureSource == EThermalTemperatureSource::SkeletalSections)
+        {
+            // Base and max temperature are shared by the whole skeletal mesh
+            UMaterialExpressionScalarParameter* NodeBaseTemperatureParam = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeBaseTemperaturePos, "BaseTemperature", 0.0f);
+            NodeBaseTemperatureParam->bUseCustomPrimitiveData = true;
+            NodeBaseTemperatureParam->PrimitiveDataIndex = ThermalPrimitiveData::BaseTemperature;
+
+            UMaterialExpressionScalarParameter* NodeMaxTemperatureParam = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeMaxTemperaturePos, "MaxTemperature", 1.0f);
+            NodeMaxTemperatureParam->bUseCustomPrimitiveData = true;
+            NodeMaxTemperatureParam->PrimitiveDataIndex = ThermalPrimitiveData::MaxTemperature;
+
+            // The current temperature of every material slot, two float4 vectors of custom primitive data
+            UMaterialExpressionVectorParameter* NodeSectionTemperaturesA = MaterialUtils::CreateVectorParameterNode(MaterialFunction, FVector2D(-1450, 150), "SectionTemperaturesA", FLinearColor(0.5f, 0.5f, 0.5f, 0.5f));
+            NodeSectionTemperaturesA->bUseCustomPrimitiveData = true;
+            NodeSectionTemperaturesA->PrimitiveDataIndex = ThermalPrimitiveData::SectionTemperatures;
+            Expressions.Add(NodeSectionTemperaturesA);
+
+            UMaterialExpressionVectorParameter* NodeSectionTemperaturesB = MaterialUtils::CreateVectorParameterNode(MaterialFunction, FVector2D(-1450, 400), "SectionTemperaturesB", FLinearColor(0.5f, 0.5f, 0.5f, 0.5f));
+            NodeSectionTemperaturesB->bUseCustomPrimitiveData = true;
+            NodeSectionTemperaturesB->PrimitiveDataIndex = ThermalPrimitiveData::SectionTemperatures + 4;
+            Expressions.Add(NodeSectionTemperaturesB);
+
+            // One hot masks set on the material instance of each slot, the dot products pick the temperature of that slot
+            UMaterialExpressionVectorParameter* NodeSectionMaskA = MaterialUtils::CreateVectorParameterNode(MaterialFunction, FVector2D(-1450, 650), "ThermalSectionMaskA", FLinearColor(1.0f, 0.0f, 0.0f, 0.0f));
+            Expressions.Add(NodeSectionMaskA);
+
+            UMaterialExpressionVectorParameter* NodeSectionMaskB = MaterialUtils::CreateVectorParameterNode(MaterialFunction, FVector2D(-1450, 900), "ThermalSectionMaskB", FLinearColor(0.0f, 0.0f, 0.0f, 0.0f));
+            Expressions.Add(NodeSectionMaskB);
+
+            // Output 5 of a vector parameter is RGBA
+            constexpr int32 RGBAOutputIndex = 5;
+
+            UMaterialExpressionDotProduct* NodeSectionDotA = MaterialUtils::CreateDotProductNode(MaterialFunction, FVector2D(-1150, 250));
+            NodeSectionDotA->A.Connect(RGBAOutputIndex, NodeSectionTemperaturesA);
+            NodeSectionDotA->B.Connect(RGBAOutputIndex, NodeSectionMaskA);
+            Expressions.Add(NodeSectionDotA);
+
+            UMaterialExpressionDotProduct* NodeSectionDotB = MaterialUtils::CreateDotProductNode(MaterialFunction, FVector2D(-1150, 450));
+            NodeSectionDotB->A.Connect(RGBAOutputIndex, NodeSectionTemperaturesB);
+            NodeSectionDotB->B.Connect(RGBAOutputIndex, NodeSectionMaskB);
+            Expressions.Add(NodeSectionDotB);
+
+            UMaterialExpressionAdd* NodeSectionTemperature = MaterialUtils::CreateAddNode(MaterialFunction, NodeCurrentTemperaturePos);
+            NodeSectionTemperature->A.Connect(0, NodeSectionDotA);
+            NodeSectionTemperature->B.Connect(0, NodeSectionDotB);
+
+            NodeBaseTemperature = NodeBaseTemperatureParam;
+            NodeCurrentTemperature = NodeSectionTemperature;
+            NodeMaxTemperature = NodeMaxTemperatureParam;
+        }
+        else
+        {
+            UMaterialExpressionScalarParameter* NodeBaseTemperatureParam = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeBaseTemperaturePos, "BaseTemperature", 0.0f);
+            UMaterialExpressionScalarParameter* NodeCurrentTemperatureParam = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeCurrentTemperaturePos, "CurrentTemperature", 0.5f);
+            UMaterialExpressionScalarParameter* NodeMaxTemperatureParam = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeMaxTemperaturePos, "MaxTemperature", 1.0f);
+
+            // Read the temperatures from custom primitive data instead of material parameters, so every thermal mesh can share one material
+            if (TemperatureSource == EThermalTemperatureSource::CustomPrimitiveData)
+            {
+                NodeBaseTemperatureParam->bUseCustomPrimitiveData = true;
+                NodeBaseTemperatureParam->PrimitiveDataIndex = ThermalPrimitiveData::BaseTemperature;
+
+                NodeCurrentTemperatureParam->bUseCustomPrimitiveData = true;
+                NodeCurrentTemperatureParam->PrimitiveDataIndex = ThermalPrimitiveData::CurrentTemperature;
+
+                NodeMaxTemperatureParam->bUseCustomPrimitiveData = true;
+                NodeMaxTemperatureParam->PrimitiveDataIndex = ThermalPrimitiveData::MaxTemperature;
+            }
+
+            NodeBaseTemperature = NodeBaseTemperatureParam;
+            NodeCurrentTemperature = NodeCurrentTemperatureParam;
+            NodeMaxTemperature = NodeMaxTemperatureParam;
+        }
+
+        Expressions.Add(NodeBaseTemperature);
+        Expressions.Add(NodeCurrentTemperature);
         Expressions.Add(NodeMaxTemperature);
 
         // 3ColorBlend-node
@@ -222,6 +307,56 @@ namespace Logi::ThermalMaterialFunction
         Expressions.Add(NodeOutputResult);
 
 
+        // Emissivity and reflectivity of the thermal material class of the mesh
+        const FVector2D NodeEmissivityPos(-400, 550);
+        UMaterialExpressionScalarParameter* NodeEmissivity = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeEmissivityPos, "Emissivity", 1.0f);
+        Expressions.Add(NodeEmissivity);
+
+        const FVector2D NodeReflectivityPos(-400, 700);
+        UMaterialExpressionScalarParameter* NodeReflectivity = MaterialUtils::CreateScalarParameterNode(MaterialFunction, NodeReflectivityPos, "Reflectivity", 0.0f);
+        Expressions.Add(NodeReflectivity);
+
+        // Every variant except the dynamic material instance one shares its material, the class comes from custom primitive data
+        if (TemperatureSource != EThermalTemperatureSource::MaterialParameter)
+        {
+            NodeEmissivity->bUseCustomPrimitiveData = true;
+            NodeEmissivity->PrimitiveDataIndex = ThermalPrimitiveData::Emissivity;
+
+            NodeReflectivity->bUseCustomPrimitiveData = true;
+            NodeReflectivity->PrimitiveDataIndex = ThermalPrimitiveData::Reflectivity;
+        }
+
+        // SkyTemperature-node, what a surface that does not emit shows instead
+        const FVector2D NodeSkyTemperaturePos(-400, 850);
+        UMaterialExpressionCollectionParameter* NodeSkyTemperature = MaterialUtils::CreateThermalSettingsCPNode(MaterialFunction, NodeSkyTemperaturePos, TEXT("SkyTemperature"), EThermalSettingsParamType::Scalar);
+        Expressions.Add(NodeSkyTemperature);
+
+        // Lerp-node, the emitted share of the temperature over the reflected sky
+        const FVector2D NodeEmissivityLerpPos(-150, 300);
+        UMaterialExpressionLinearInterpolate* NodeEmissivityLerp = MaterialUtils::CreateLerpNode(MaterialFunction, NodeEmissivityLerpPos);
+        Expressions.Add(NodeEmissivityLerp);
+
+        NodeEmissivityLerp->A.Connect(0, NodeSkyTemperature);
+        NodeEmissivityLerp->B.Connect(0, EmissiveColor3ColorBlendNode);
+        NodeEmissivityLerp->Alpha.Connect(0, NodeEmissivity);
+
+        // Multiply-node, the reflection grows toward grazing angles
+        const FVector2D NodeReflectionAlphaPos(-150, 700);
+        UMaterialExpressionMultiply* NodeReflectionAlpha = MaterialUtils::CreateMultiplyNode(MaterialFunction, NodeReflectionAlphaPos);
+        Expressions.Add(NodeReflectionAlpha);
+
+        NodeReflectionAlpha->A.Connect(0, NodeReflectivity);
+        NodeReflectionAlpha->B.Connect(0, NodeFresnel);
+
+        // Lerp-node, reflected sky on top of the emitted temperature
+        const FVector2D NodeReflectionLerpPos(100, 300);
+        UMaterialExpressionLinearInterpolate* NodeReflectionLerp = MaterialUtils::CreateLerpNode(MaterialFunction, NodeReflectionLerpPos);
+        Expressions.Add(NodeReflectionLerp);
+
+        NodeReflectionLerp->A.Connect(0, NodeEmissivityLerp);
+        NodeReflectionLerp->B.Connect(0, NodeSkyTemperature);
+        NodeReflectionLerp->Alpha.Connect(0, NodeReflectionAlpha);
+
         /* LINKING */
 
         // Link SpecularColor to Specular
@@ -237,8 +372,8 @@ namespace Logi::ThermalMaterialFunction
         // OutputResult connection
         NodeOutputResult->A.Connect(0, NodeMaterialAttributes); // A == the input on the "Output" node
 
-        // Link Lerp to EmissiveColor on MaterialAttributes-node
-        NodeMaterialAttributes->EmissiveColor.Connect(0, EmissiveColor3ColorBlendNode);
+        // Link the reflection Lerp to EmissiveColor on MaterialAttributes-node
+        NodeMaterialAttributes->EmissiveColor.Connect(0, NodeReflectionLerp);
 
 
         /* Finish */
@@ -270,4 +405,40 @@ namespace Logi::ThermalMaterialFunction
 
     }
 
+    void CreateMaterialFunction(bool& bSuccess, FString& StatusMessage)
+    {
+        // Material function for the dynamic material instance mode
+        CreateMaterialFunctionAsset("MF_Logi_ThermalMaterialFunction", EThermalTemperatureSource::MaterialParameter, bSuccess, StatusMessage);
+
+        if (!bSuccess)
+        {
+            return;
+        }
+
+        UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+        // Material function for the custom primitive data mode
+        CreateMaterialFunctionAsset("MF_Logi_ThermalMaterialFunction_CPD", EThermalTemperatureSource::CustomPrimitiveData, bSuccess, StatusMessage);
+
+        if (!bSuccess)
+        {
+            return;
+        }
+
+        UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+        // Material function for instanced static meshes, one temperature per instance
+        CreateMaterialFunctionAsset("MF_Logi_ThermalMaterialFunction_Instanced", EThermalTemperatureSource::PerInstanceCustomData, bSuccess, StatusMessage);
+
+        if (!bSuccess)
+        {
+            return;
+        }
+
+        UE_LOG(LogTemp, Warning, TEXT("%s"), *StatusMessage);
+
+        // Material function for skeletal meshes, one temperature per material slot
+        CreateMaterialFunctionAsset("MF_Logi_ThermalMaterialFunction_Skeletal", EThermalTemperatureSource::SkeletalSections, bSuccess, StatusMessage);
+    }
+
 }
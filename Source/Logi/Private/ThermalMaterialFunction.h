@@ -6,6 +6,17 @@ class UMaterialFunction;
 
 namespace Logi::ThermalMaterialFunction
 {
+	// Where the thermal material function reads the temperatures from
+	enum class EThermalTemperatureSource
+	{
+		MaterialParameter,
+		CustomPrimitiveData,
+		PerInstanceCustomData,
+		SkeletalSections
+	};
+
+	void CreateMaterialFunctionAsset(const FString& AssetName, EThermalTemperatureSource TemperatureSource, bool& bSuccess, FString& StatusMessage);
+
 	void CreateMaterialFunction(bool& bSuccess, FString& StatusMessage);
 };
 
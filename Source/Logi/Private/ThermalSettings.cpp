@@ -49,6 +49,14 @@ namespace Logi::MPCThermalSettings
 				const FName SkyTemperatureName = FName("SkyTemperature");
 				const float SkyTemperatureDefaultValue = 0.0f;
 				MaterialUtils::AddScalarParameter(ThermalSettings, SkyTemperatureName, SkyTemperatureDefaultValue);
+
+				const FName PaletteName = FName("Palette");
+				const float PaletteDefaultValue = 0.0f;
+				MaterialUtils::AddScalarParameter(ThermalSettings, PaletteName, PaletteDefaultValue);
+
+				const FName NoiseModeName = FName("NoiseMode");
+				const float NoiseModeDefaultValue = 0.0f;
+				MaterialUtils::AddScalarParameter(ThermalSettings, NoiseModeName, NoiseModeDefaultValue);
 				
 				// Adding Vector parameters
 
@@ -68,6 +76,10 @@ namespace Logi::MPCThermalSettings
 				const FLinearColor NoiseSizeDefaultValue = FLinearColor(0, 0, 0, 0);
 				MaterialUtils::AddVectorParameter(ThermalSettings, NoiseSizeName, NoiseSizeDefaultValue);
 
+				const FName SensorResolutionName = FName("SensorResolution");
+				const FLinearColor SensorResolutionDefaultValue = FLinearColor(0, 0, 0, 0);
+				MaterialUtils::AddVectorParameter(ThermalSettings, SensorResolutionName, SensorResolutionDefaultValue);
+
 				//Save the MPC with parameters
 				ThermalSettings->MarkPackageDirty();
 				FAssetRegistryModule::AssetCreated(ThermalSettings);
@@ -103,6 +115,8 @@ namespace Logi::MPCThermalSettings
 			FName("Blur"),
 			FName("NoiseAmount"),
 			FName("SkyTemperature"),
+			FName("Palette"),
+			FName("NoiseMode"),
 		};
 
 		for (const FName& ScalarName : ScalarsRequired)
@@ -125,7 +139,8 @@ namespace Logi::MPCThermalSettings
 			{ FName("Cold"), FLinearColor(1, 1, 1, 1) },
 			{ FName("Mid"), FLinearColor(0, 1, 0, 1) },
 			{ FName("Hot"), FLinearColor(1, 0, 0, 1) },
-			{ FName("NoiseSize"), FLinearColor(0, 0, 0, 0) }
+			{ FName("NoiseSize"), FLinearColor(0, 0, 0, 0) },
+			{ FName("SensorResolution"), FLinearColor(0, 0, 0, 0) }
 		};
 
 		for (const TPair<FName, FLinearColor>& VectorPair : VectorsRequired)
@@ -178,11 +193,14 @@ namespace Logi::MPCThermalSettings
 			Instance->SetScalarParameterValue(FName("Blur"), 0);
 			Instance->SetScalarParameterValue(FName("NoiseAmount"), 0.05);
 			Instance->SetScalarParameterValue(FName("SkyTemperature"), 0);
+			Instance->SetScalarParameterValue(FName("Palette"), 0);
+			Instance->SetScalarParameterValue(FName("NoiseMode"), 0);
 
 			Instance->SetVectorParameterValue(FName("Cold"), FLinearColor(0,0,0,0));
 			Instance->SetVectorParameterValue(FName("Mid"), FLinearColor(0.5, 0.5, 0.5, 0));
 			Instance->SetVectorParameterValue(FName("Hot"), FLinearColor(1,1,1,0));
 			Instance->SetVectorParameterValue(FName("NoiseSize"), FLinearColor(1,1,1,0));
+			Instance->SetVectorParameterValue(FName("SensorResolution"), FLinearColor(0,0,0,0));
 
 			UE_LOG(LogTemp, Warning, TEXT("Thermal settings applied."));
 		}
@@ -11,7 +11,9 @@
 #include "Materials/MaterialExpressionConstant.h"
 #include "Materials/MaterialExpressionConstant2Vector.h"
 #include "Materials/MaterialExpressionConstant3Vector.h"
+#include "Materials/MaterialExpressionCustom.h"
 #include "Materials/MaterialExpressionDivide.h"
+#include "Materials/MaterialExpressionDotProduct.h"
 #include "Materials/MaterialExpressionFloor.h"
 #include "Materials/MaterialExpressionFresnel.h"
 #include "Materials/MaterialExpressionIf.h"
@@ -25,6 +27,7 @@
 #include "Materials/MaterialExpressionTextureCoordinate.h"
 #include "Materials/MaterialExpressionTime.h"
 #include "Materials/MaterialExpressionVectorNoise.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
 #include "Materials/MaterialParameterCollection.h"
 #include "Materials/MaterialExpressionFunctionOutput.h"
 
@@ -183,6 +186,22 @@ namespace Logi::MaterialUtils
         return DivideNode;
     }
     
+    UMaterialExpressionDotProduct* CreateDotProductNode(UObject* Outer, const FVector2D& EditorPos)
+    {
+        // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
+        if (!IsOuterAMaterialOrFunction(Outer))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid Outer passed to CreateDotProductNode"));
+            return nullptr;
+        }
+
+        UMaterialExpressionDotProduct* DotProductNode = NewObject<UMaterialExpressionDotProduct>(Outer);
+        DotProductNode->MaterialExpressionEditorX = EditorPos.X;
+        DotProductNode->MaterialExpressionEditorY = EditorPos.Y;
+
+        return DotProductNode;
+    }
+
     UMaterialExpressionIf* CreateIfNode(UObject* Outer, const FVector2D& EditorPos)
     {
         // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
@@ -344,6 +363,24 @@ namespace Logi::MaterialUtils
         return TextureCoordinateNode;
     }
     
+    UMaterialExpressionTextureObject* CreateTextureObjectNode(UObject* Outer, const FVector2D& EditorPos, UTexture* Texture)
+    {
+        // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
+        if (!IsOuterAMaterialOrFunction(Outer))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid Outer passed to CreateTextureObjectNode"));
+            return nullptr;
+        }
+
+        UMaterialExpressionTextureObject* TextureObjectNode = NewObject<UMaterialExpressionTextureObject>(Outer);
+        TextureObjectNode->MaterialExpressionEditorX = EditorPos.X;
+        TextureObjectNode->MaterialExpressionEditorY = EditorPos.Y;
+        TextureObjectNode->Texture = Texture;
+        TextureObjectNode->AutoSetSampleType();
+
+        return TextureObjectNode;
+    }
+
     UMaterialExpressionVectorNoise* CreateVectorNoiseNode(UObject* Outer, const FVector2D& EditorPos)
     {
         // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
@@ -572,6 +609,42 @@ namespace Logi::MaterialUtils
         return ScalarParameterNode;
     }
 
+    UMaterialExpressionVectorParameter* CreateVectorParameterNode(UObject* Outer, const FVector2D& EditorPos, const FName& ParameterName, const FLinearColor& DefaultValue)
+    {
+        // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
+        if (!IsOuterAMaterialOrFunction(Outer))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid Outer passed to CreateVectorParameterNode"));
+            return nullptr;
+        }
+
+        UMaterialExpressionVectorParameter* VectorParameterNode = NewObject<UMaterialExpressionVectorParameter>(Outer);
+        VectorParameterNode->MaterialExpressionEditorX = EditorPos.X;
+        VectorParameterNode->MaterialExpressionEditorY = EditorPos.Y;
+        VectorParameterNode->ParameterName = ParameterName;
+        VectorParameterNode->DefaultValue = DefaultValue;
+
+        return VectorParameterNode;
+    }
+
+    UMaterialExpressionPerInstanceCustomData* CreatePerInstanceCustomDataNode(UObject* Outer, const FVector2D& EditorPos, const uint32 DataIndex, const float DefaultValue)
+    {
+        // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
+        if (!IsOuterAMaterialOrFunction(Outer))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid Outer passed to CreatePerInstanceCustomDataNode"));
+            return nullptr;
+        }
+
+        UMaterialExpressionPerInstanceCustomData* PerInstanceCustomDataNode = NewObject<UMaterialExpressionPerInstanceCustomData>(Outer);
+        PerInstanceCustomDataNode->MaterialExpressionEditorX = EditorPos.X;
+        PerInstanceCustomDataNode->MaterialExpressionEditorY = EditorPos.Y;
+        PerInstanceCustomDataNode->DataIndex = DataIndex;
+        PerInstanceCustomDataNode->ConstDefaultValue = DefaultValue;
+
+        return PerInstanceCustomDataNode;
+    }
+
     UMaterialExpressionCollectionParameter* CreateThermalSettingsCPNode(UObject* Outer, const FVector2D& EditorPos, const FName& ParameterName, const EThermalSettingsParamType ParamType)
     {
 
@@ -725,6 +798,33 @@ namespace Logi::MaterialUtils
         return MaterialAttrNode;
     }
 
+    UMaterialExpressionCustom* CreateCustomNode(UObject* Outer, const FVector2D& EditorPos, const FString& Description, const FString& Code, const ECustomMaterialOutputType OutputType, const TArray<FName>& InputNames)
+    {
+        // If Outer is not a UMaterial or UMaterialFunctionInterface(UMaterialFunction + others)
+        if (!IsOuterAMaterialOrFunction(Outer))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid Outer passed to CreateCustomNode"));
+            return nullptr;
+        }
+
+        UMaterialExpressionCustom* CustomNode = NewObject<UMaterialExpressionCustom>(Outer);
+        CustomNode->MaterialExpressionEditorX = EditorPos.X;
+        CustomNode->MaterialExpressionEditorY = EditorPos.Y;
+        CustomNode->Description = Description;
+        CustomNode->Code = Code;
+        CustomNode->OutputType = OutputType;
+
+        // A new Custom-node comes with one unnamed input, replace it with the named ones the code reads
+        CustomNode->Inputs.Reset();
+        for (const FName& InputName : InputNames)
+        {
+            FCustomInput& Input = CustomNode->Inputs.AddDefaulted_GetRef();
+            Input.InputName = InputName;
+        }
+
+        return CustomNode;
+    }
+
 
     // === Material Parameter Collection Functions ===
 
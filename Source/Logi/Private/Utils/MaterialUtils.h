@@ -10,7 +10,9 @@
 #include "Materials/MaterialExpressionConstant.h"
 #include "Materials/MaterialExpressionConstant2Vector.h"
 #include "Materials/MaterialExpressionConstant3Vector.h"
+#include "Materials/MaterialExpressionCustom.h"
 #include "Materials/MaterialExpressionDivide.h"
+#include "Materials/MaterialExpressionDotProduct.h"
 #include "Materials/MaterialExpressionFloor.h"
 #include "Materials/MaterialExpressionFresnel.h"
 #include "Materials/MaterialExpressionIf.h"
@@ -19,12 +21,15 @@
 #include "Materials/MaterialExpressionMax.h"
 #include "Materials/MaterialExpressionMultiply.h"
 #include "Materials/MaterialExpressionOneMinus.h"
+#include "Materials/MaterialExpressionPerInstanceCustomData.h"
 #include "Materials/MaterialExpressionPixelNormalWS.h"
 #include "Materials/MaterialExpressionPower.h"
 #include "Materials/MaterialExpressionScalarParameter.h"
 #include "Materials/MaterialExpressionStep.h"
 #include "Materials/MaterialExpressionTextureCoordinate.h"
+#include "Materials/MaterialExpressionTextureObject.h"
 #include "Materials/MaterialExpressionTime.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
 #include "Materials/MaterialExpressionVectorNoise.h"
 #include "Materials/MaterialExpressionFunctionOutput.h"
 
@@ -42,6 +47,7 @@ namespace Logi::MaterialUtils
     UMaterialExpressionStep* CreateStepNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionPower* CreatePowerNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionDivide* CreateDivideNode(UObject* Outer, const FVector2D& EditorPos);
+    UMaterialExpressionDotProduct* CreateDotProductNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionIf* CreateIfNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionClamp* CreateClampNode(UObject* Outer, const FVector2D& EditorPos, std::optional<float> MinValue = std::nullopt, std::optional<float> MaxValue = std::nullopt);
     UMaterialExpressionFloor* CreateFloorNode(UObject* Outer, const FVector2D& EditorPos);
@@ -51,6 +57,7 @@ namespace Logi::MaterialUtils
     UMaterialExpressionPixelNormalWS* CreatePixelNormalWSNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionTime* CreateTimeNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionTextureCoordinate* CreateTextureCoordinateNode(UObject* Outer, const FVector2D& EditorPos);
+    UMaterialExpressionTextureObject* CreateTextureObjectNode(UObject* Outer, const FVector2D& EditorPos, UTexture* Texture);
     UMaterialExpressionVectorNoise* CreateVectorNoiseNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionAppendVector* CreateAppendVectorNode(UObject* Outer, const FVector2D& EditorPos);
     UMaterialExpressionComponentMask* CreateMaskNode(UObject* Outer, const FVector2D& EditorPos, bool R, bool G, bool B);
@@ -64,12 +71,15 @@ namespace Logi::MaterialUtils
 
     // Parameter & Collection Nodes
     UMaterialExpressionScalarParameter* CreateScalarParameterNode(UObject* Outer, const FVector2D& EditorPos, const FName& ParameterName, float DefaultValue);
+    UMaterialExpressionVectorParameter* CreateVectorParameterNode(UObject* Outer, const FVector2D& EditorPos, const FName& ParameterName, const FLinearColor& DefaultValue);
+    UMaterialExpressionPerInstanceCustomData* CreatePerInstanceCustomDataNode(UObject* Outer, const FVector2D& EditorPos, uint32 DataIndex, float DefaultValue);
     UMaterialExpressionCollectionParameter* CreateThermalSettingsCPNode(UObject* Outer, const FVector2D& EditorPos, const FName& ParameterName, EThermalSettingsParamType ParamType);
 
     // Other Nodes
     UMaterialExpressionComment* CreateCommentNode(UObject* Outer, const FVector2D& EditorPos, const FVector2D& Size, const FString& CommentText, const FLinearColor& BoxColor = FLinearColor::White);
     UMaterialExpressionFresnel* CreateFresnelNode(UObject* Outer, const FVector2D& EditorPos, std::optional<float> BaseReflectFractionValue = std::nullopt, std::optional<float> ExponentValue = std::nullopt);
     UMaterialExpressionMakeMaterialAttributes* CreateMaterialAttributesNode(UObject* Outer, const FVector2D& EditorPos);
+    UMaterialExpressionCustom* CreateCustomNode(UObject* Outer, const FVector2D& EditorPos, const FString& Description, const FString& Code, ECustomMaterialOutputType OutputType, const TArray<FName>& InputNames);
 
     // Material Parameter Collection Functions
     void AddScalarParameter(UMaterialParameterCollection* Collection, const FName& ParameterName, float DefaultValue);
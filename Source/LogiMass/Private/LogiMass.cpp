@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LogiMass.h"
+
+#define LOCTEXT_NAMESPACE "FLogiMassModule"
+
+void FLogiMassModule::StartupModule()
+{
+	// MassEntity side of Logi. Crowd and traffic agents have no actors, they get their temperatures from fragments
+	// and are drawn by the instanced thermal material. Kept apart so projects without Mass do not need the Mass plugins.
+}
+
+void FLogiMassModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FLogiMassModule, LogiMass)
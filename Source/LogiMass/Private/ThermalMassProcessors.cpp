@@ -0,0 +1,119 @@
+#include "ThermalMassProcessors.h"
+
+#include "Kismet/KismetMathLibrary.h"
+#include "LogiSettings.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "MassRepresentationFragments.h"
+#include "MassRepresentationSubsystem.h"
+#include "MassVisualizationComponent.h"
+#include "ThermalControllerActor.h"
+#include "ThermalMassFragments.h"
+#include "ThermalProfile.h"
+#include "ThermalStats.h"
+#include "ThermalWorldSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Thermal Mass profiles"), STAT_LogiThermalMassProfiles, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal Mass ISM update"), STAT_LogiThermalMassISMUpdate, STATGROUP_Logi);
+
+static_assert(sizeof(FThermalInstanceCustomData) == ThermalPrimitiveData::NumFloats * sizeof(float) && ThermalPrimitiveData::BaseTemperature == 0
+	&& ThermalPrimitiveData::CurrentTemperature == 1 && ThermalPrimitiveData::MaxTemperature == 2,
+	"The custom data of Mass agents has to match the per instance custom data the instanced thermal material reads");
+
+UThermalProfileProcessor::UThermalProfileProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Representation);
+}
+
+void UThermalProfileProcessor::ConfigureQueries()
+{
+	//Only agents with a profile, the rest keep the temperatures gameplay gives them
+	EntityQuery.AddRequirement<FThermalFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FThermalProfileFragment>();
+}
+
+void UThermalProfileProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalMassProfiles);
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& Context)
+	{
+		//Every agent of a chunk shares the profile
+		const UThermalProfile* Profile = Context.GetConstSharedFragment<FThermalProfileFragment>().Profile;
+		if (!Profile || Profile->GetLUT().Num() != UThermalProfile::LUTSize) return;
+
+		const float DeltaTime = Context.GetDeltaTimeSeconds();
+		const float Duration = Profile->GetDuration();
+		const bool bLoop = Profile->IsLooping();
+		const TArrayView<FThermalFragment> ThermalList = Context.GetMutableFragmentView<FThermalFragment>();
+
+		for (FThermalFragment& Thermal : ThermalList) {
+			//Finished profiles hold their last sample, the time stops growing so it does not lose precision
+			Thermal.ProfileTime = bLoop && Duration > 0.0f ? FMath::Fmod(Thermal.ProfileTime + DeltaTime, Duration) : FMath::Min(Thermal.ProfileTime + DeltaTime, Duration);
+			Thermal.CurrentTemperature = FMath::Lerp(Thermal.BaseTemperature, Thermal.MaxTemperature, Profile->Evaluate(Thermal.ProfileTime));
+		}
+	});
+}
+
+UThermalUpdateISMProcessor::UThermalUpdateISMProcessor()
+{
+	ExecutionOrder.ExecuteAfter.Add(UThermalProfileProcessor::StaticClass()->GetFName());
+}
+
+void UThermalUpdateISMProcessor::ConfigureQueries()
+{
+	Super::ConfigureQueries();
+
+	//Agents without temperatures only get their transforms, like with the default ISM update
+	EntityQuery.AddRequirement<FThermalFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+}
+
+void UThermalUpdateISMProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalMassISMUpdate);
+
+	//Agents are normalized to the range of the controller of the world, like thermal actors
+	const UThermalWorldSubsystem* ThermalSubsystem = UWorld::GetSubsystem<UThermalWorldSubsystem>(EntityManager.GetWorld());
+	const AThermalController* Controller = ThermalSubsystem ? ThermalSubsystem->GetThermalController() : nullptr;
+	const float RangeMin = Controller ? Controller->GetThermalCameraRangeMin() : 0.0f;
+	const float RangeMax = Controller ? Controller->GetThermalCameraRangeMax() : 100.0f;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [RangeMin, RangeMax](FMassExecutionContext& Context)
+	{
+		UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
+		check(RepresentationSubsystem);
+		FMassInstancedStaticMeshInfoArrayView ISMInfos = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+
+		const TConstArrayView<FTransformFragment> TransformList = Context.GetFragmentView<FTransformFragment>();
+		const TArrayView<FMassRepresentationFragment> RepresentationList = Context.GetMutableFragmentView<FMassRepresentationFragment>();
+		const TConstArrayView<FMassRepresentationLODFragment> RepresentationLODList = Context.GetFragmentView<FMassRepresentationLODFragment>();
+		const TConstArrayView<FThermalFragment> ThermalList = Context.GetFragmentView<FThermalFragment>();
+
+		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex) {
+			const FTransform& Transform = TransformList[EntityIndex].GetTransform();
+			FMassRepresentationFragment& Representation = RepresentationList[EntityIndex];
+			const FMassRepresentationLODFragment& RepresentationLOD = RepresentationLODList[EntityIndex];
+
+			if (Representation.CurrentRepresentation == EMassRepresentationType::StaticMeshInstance) {
+				FMassInstancedStaticMeshInfo& ISMInfo = ISMInfos[Representation.StaticMeshDescIndex];
+				UpdateISMTransform(GetTypeHash(Context.GetEntity(EntityIndex)), ISMInfo, Transform, Representation.PrevTransform, RepresentationLOD.LODSignificance, Representation.PrevLODSignificance);
+
+				//Batched in the same order as the transforms, so each instance gets the temperatures of its agent
+				if (ThermalList.Num() > 0) {
+					const FThermalFragment& Thermal = ThermalList[EntityIndex];
+
+					FThermalInstanceCustomData CustomData;
+					CustomData.BaseTemperature = UKismetMathLibrary::NormalizeToRange(Thermal.BaseTemperature, RangeMin, RangeMax);
+					CustomData.CurrentTemperature = UKismetMathLibrary::NormalizeToRange(Thermal.CurrentTemperature, RangeMin, RangeMax);
+					CustomData.MaxTemperature = UKismetMathLibrary::NormalizeToRange(Thermal.MaxTemperature, RangeMin, RangeMax);
+					ISMInfo.AddBatchedCustomData(CustomData, RepresentationLOD.LODSignificance, Representation.PrevLODSignificance);
+				}
+			}
+
+			Representation.PrevTransform = Transform;
+			Representation.PrevLODSignificance = RepresentationLOD.LODSignificance;
+		}
+	});
+}
@@ -0,0 +1,20 @@
+#include "ThermalMassTrait.h"
+
+#include "MassEntityManager.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+#include "ThermalProfile.h"
+
+void UThermalMassTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.AddFragment_GetRef<FThermalFragment>() = Thermal;
+
+	//Agents without a profile keep the current temperature gameplay gives them
+	if (Profile) {
+		FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+		FThermalProfileFragment ProfileFragment;
+		ProfileFragment.Profile = Profile;
+		BuildContext.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(ProfileFragment));
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "ThermalMassFragments.generated.h"
+
+class UThermalProfile;
+
+// Temperatures of one Mass agent, the counterpart of FThermalState for entities without an actor
+USTRUCT(BlueprintType)
+struct LOGIMASS_API FThermalFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi")
+	float BaseTemperature = 0.0f;
+
+	// Follows the profile of the agent when it has one, otherwise set by gameplay processors
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi")
+	float CurrentTemperature = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi")
+	float MaxTemperature = 25.0f;
+
+	// Seconds the profile has played
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi")
+	float ProfileTime = 0.0f;
+};
+
+// Profile shared by every agent of an entity config, e.g. the engine profile of a vehicle type
+USTRUCT()
+struct LOGIMASS_API FThermalProfileFragment : public FMassSharedFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<const UThermalProfile> Profile;
+};
+
+// Per instance custom data of one agent, normalized to the thermal camera range like the instances of thermal actors
+struct FThermalInstanceCustomData
+{
+	float BaseTemperature = 0.0f;
+	float CurrentTemperature = 0.0f;
+	float MaxTemperature = 0.0f;
+};
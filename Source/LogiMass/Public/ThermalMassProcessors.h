@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassUpdateISMProcessor.h"
+#include "ThermalMassProcessors.generated.h"
+
+/**
+ * Plays the thermal profiles of Mass agents, one entity chunk per task. Runs before the representation processors
+ * so the ISM update sends the temperatures of this frame. The chunks read the baked profile tables, so the processor
+ * must not run concurrently with an edit of a profile asset (see UThermalProfile::Bake).
+ */
+UCLASS()
+class LOGIMASS_API UThermalProfileProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UThermalProfileProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * UMassUpdateISMProcessor that also writes the temperatures of thermal agents to the per instance custom data of their
+ * static mesh instances, normalized to the range of the thermal controller as the instanced thermal material expects.
+ * Replaces the default ISM update, so disable UMassUpdateISMProcessor in DefaultMass.ini like the crowd vertex
+ * animation processor does. Thermal and non thermal agents must not share a static mesh description, the custom data
+ * of one instance buffer has to cover every instance.
+ */
+UCLASS()
+class LOGIMASS_API UThermalUpdateISMProcessor : public UMassUpdateISMProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UThermalUpdateISMProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+};
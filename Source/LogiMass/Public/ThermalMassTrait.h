@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "ThermalMassFragments.h"
+#include "ThermalMassTrait.generated.h"
+
+class UThermalProfile;
+
+/**
+ * Makes the agents of a Mass entity config thermal. Their static mesh instances need the instanced thermal material
+ * (M_Logi_ThermalMaterial_Instanced), the temperatures are written to the per instance custom data by UThermalUpdateISMProcessor.
+ */
+UCLASS(meta = (DisplayName = "Logi Thermal"))
+class LOGIMASS_API UThermalMassTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+
+	// Temperatures every agent starts with
+	UPROPERTY(EditAnywhere, Category = "Logi")
+	FThermalFragment Thermal;
+
+	// Played by every agent from when it spawns, the current temperature follows it
+	UPROPERTY(EditAnywhere, Category = "Logi")
+	TObjectPtr<UThermalProfile> Profile;
+};
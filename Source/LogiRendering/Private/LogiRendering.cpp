@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LogiRendering.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
+
+#define LOCTEXT_NAMESPACE "FLogiRenderingModule"
+
+void FLogiRenderingModule::StartupModule()
+{
+	// Native thermal image passes. Loaded at PostConfigInit so the shader directory is mapped before the global shaders compile,
+	// which is also why nothing in here may use UObjects of the other Logi modules.
+	const FString ShaderDirectory = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("Logi"))->GetBaseDir(), TEXT("Shaders"));
+	AddShaderSourceDirectoryMapping(TEXT("/Plugin/Logi"), ShaderDirectory);
+}
+
+void FLogiRenderingModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FLogiRenderingModule, LogiRendering)
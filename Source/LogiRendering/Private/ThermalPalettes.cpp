@@ -0,0 +1,99 @@
+#include "ThermalPalettes.h"
+
+namespace
+{
+	struct FPaletteStop
+	{
+		float Position;
+		FColor Color;
+	};
+
+	//Iron, black through purple and orange to near white
+	const FPaletteStop IronStops[] = {
+		{ 0.0f, FColor(0, 0, 0) },
+		{ 0.15f, FColor(32, 0, 96) },
+		{ 0.35f, FColor(145, 16, 140) },
+		{ 0.55f, FColor(225, 70, 40) },
+		{ 0.75f, FColor(250, 160, 0) },
+		{ 0.9f, FColor(255, 225, 70) },
+		{ 1.0f, FColor(255, 255, 235) }
+	};
+
+	//Rainbow, dark blue through cyan, green, yellow and red to white
+	const FPaletteStop RainbowStops[] = {
+		{ 0.0f, FColor(0, 0, 64) },
+		{ 0.15f, FColor(0, 0, 255) },
+		{ 0.35f, FColor(0, 255, 255) },
+		{ 0.5f, FColor(0, 255, 0) },
+		{ 0.65f, FColor(255, 255, 0) },
+		{ 0.85f, FColor(255, 0, 0) },
+		{ 1.0f, FColor(255, 255, 255) }
+	};
+
+	const FPaletteStop WhiteHotStops[] = {
+		{ 0.0f, FColor(0, 0, 0) },
+		{ 1.0f, FColor(255, 255, 255) }
+	};
+
+	const FPaletteStop BlackHotStops[] = {
+		{ 0.0f, FColor(255, 255, 255) },
+		{ 1.0f, FColor(0, 0, 0) }
+	};
+
+	void FillPalette(const TArrayView<const FPaletteStop> Stops, const TArrayView<FColor> OutColors)
+	{
+		check(OutColors.Num() == ThermalPalettes::Width);
+
+		int32 Stop = 0;
+
+		for (int32 Index = 0; Index < ThermalPalettes::Width; ++Index) {
+			const float Position = Index / float(ThermalPalettes::Width - 1);
+
+			while (Stop < Stops.Num() - 2 && Position > Stops[Stop + 1].Position) {
+				++Stop;
+			}
+
+			//The stops are authored in sRGB, the palettes are stored and sampled as sRGB as well
+			const FPaletteStop& From = Stops[Stop];
+			const FPaletteStop& To = Stops[Stop + 1];
+			const float Alpha = FMath::Clamp((Position - From.Position) / (To.Position - From.Position), 0.0f, 1.0f);
+
+			OutColors[Index] = FColor(
+				(uint8)FMath::RoundToInt32(FMath::Lerp<float>(From.Color.R, To.Color.R, Alpha)),
+				(uint8)FMath::RoundToInt32(FMath::Lerp<float>(From.Color.G, To.Color.G, Alpha)),
+				(uint8)FMath::RoundToInt32(FMath::Lerp<float>(From.Color.B, To.Color.B, Alpha)));
+		}
+	}
+}
+
+void ThermalPalettes::GetPaletteColors(const int32 Palette, const TArrayView<FColor> OutColors)
+{
+	switch (Palette) {
+	case 0:
+		FillPalette(IronStops, OutColors);
+		break;
+	case 1:
+		FillPalette(RainbowStops, OutColors);
+		break;
+	case 2:
+		FillPalette(WhiteHotStops, OutColors);
+		break;
+	case 3:
+		FillPalette(BlackHotStops, OutColors);
+		break;
+	default:
+		checkNoEntry();
+	}
+}
+
+void ThermalPalettes::GetThreeColorPaletteColors(const FLinearColor& Cold, const FLinearColor& Mid, const FLinearColor& Hot, const TArrayView<FColor> OutColors)
+{
+	check(OutColors.Num() == Width);
+
+	//The controller colors are linear, the blend happens in linear space like the material one did
+	for (int32 Index = 0; Index < Width; ++Index) {
+		const float Alpha = Index / float(Width - 1);
+		const FLinearColor Color = FMath::Lerp(FMath::Lerp(Cold, Mid, FMath::Clamp(Alpha * 2.0f, 0.0f, 1.0f)), Hot, FMath::Clamp(Alpha * 2.0f - 1.0f, 0.0f, 1.0f));
+		OutColors[Index] = Color.ToFColorSRGB();
+	}
+}
@@ -0,0 +1,406 @@
+#include "ThermalSceneViewExtension.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "Engine/Texture.h"
+#include "GlobalShader.h"
+#include "PostProcess/PostProcessMaterialInputs.h"
+#include "RenderGraphUtils.h"
+#include "RHIStaticStates.h"
+#include "ScreenPass.h"
+#include "SceneTexturesConfig.h"
+#include "ShaderParameterStruct.h"
+#include "TextureResource.h"
+#include "ThermalPalettes.h"
+
+static TAutoConsoleVariable<bool> CVarThermalImageAsyncCompute(
+	TEXT("Logi.Thermal.Image.AsyncCompute"),
+	false,
+	TEXT("Run the compute passes of the thermal image on the async compute queue where the RHI supports it."),
+	ECVF_RenderThreadSafe);
+
+DECLARE_GPU_STAT_NAMED(LogiThermalImage, TEXT("Logi Thermal Image"));
+DECLARE_GPU_STAT_NAMED(LogiThermalClassify, TEXT("Logi Thermal Classify"));
+DECLARE_GPU_STAT_NAMED(LogiThermalBlur, TEXT("Logi Thermal Blur"));
+DECLARE_GPU_STAT_NAMED(LogiThermalPalette, TEXT("Logi Thermal Palette"));
+DECLARE_GPU_STAT_NAMED(LogiThermalNoise, TEXT("Logi Thermal Noise"));
+DECLARE_GPU_STAT_NAMED(LogiThermalComposite, TEXT("Logi Thermal Composite"));
+
+namespace
+{
+	constexpr int32 ThermalImageGroupSize = 8;
+
+	// Blur arrives as 0-1, full Blur is a radius of 32 display pixels
+	constexpr float MaxBlurRadius = 32.0f;
+
+	// "Fersnel EXP" of PP_Logi_ThermalCamera
+	constexpr float FresnelExponent = 1.0f;
+}
+
+class FThermalImageShader : public FGlobalShader
+{
+public:
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThermalImageGroupSize);
+	}
+
+	FThermalImageShader() = default;
+	FThermalImageShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer) : FGlobalShader(Initializer) {}
+};
+
+// Scene to normalized temperature, the heat mask, background Fresnel and re-added sky of the material path
+class FThermalClassifyCS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalClassifyCS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalClassifyCS, FThermalImageShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+		SHADER_PARAMETER_RDG_UNIFORM_BUFFER(FSceneTextureUniformParameters, SceneTextures)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneColorTexture)
+		SHADER_PARAMETER(FIntPoint, SceneColorViewMin)
+		SHADER_PARAMETER(FIntPoint, SceneColorViewSize)
+		SHADER_PARAMETER(FIntPoint, ImageSize)
+		SHADER_PARAMETER(FVector2f, ImageInvSize)
+		SHADER_PARAMETER(float, BackgroundTemperature)
+		SHADER_PARAMETER(float, SkyTemperature)
+		SHADER_PARAMETER(float, FresnelExponent)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, RWTemperature)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// One direction of the separable Gaussian over the temperature
+class FThermalBlurCS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalBlurCS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalBlurCS, FThermalImageShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, TemperatureTexture)
+		SHADER_PARAMETER(FIntPoint, ImageSize)
+		SHADER_PARAMETER(FIntPoint, BlurDirection)
+		SHADER_PARAMETER(int32, BlurTaps)
+		SHADER_PARAMETER(float, BlurInvTwoSigmaSquared)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, RWTemperature)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Normalized temperature to the color of the palette lookup texture
+class FThermalPaletteCS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalPaletteCS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalPaletteCS, FThermalImageShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, TemperatureTexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PaletteTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, PaletteSampler)
+		SHADER_PARAMETER(FIntPoint, ImageSize)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, RWColor)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FThermalImageShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("PALETTE_WIDTH"), ThermalPalettes::Width);
+	}
+};
+
+// Per frame sensor noise, skipped when the noise amount is 0
+class FThermalNoiseCS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalNoiseCS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalNoiseCS, FThermalImageShader);
+
+	class FBlueNoise : SHADER_PERMUTATION_BOOL("BLUE_NOISE");
+	using FPermutationDomain = TShaderPermutationDomain<FBlueNoise>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+		SHADER_PARAMETER(FIntPoint, ImageSize)
+		SHADER_PARAMETER(float, NoiseSize)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, BlueNoiseTexture)
+		SHADER_PARAMETER(FIntPoint, BlueNoiseSize)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, RWNoise)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Palette colors plus noise, upscaled from the sensor resolution into the output image
+class FThermalCompositeCS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalCompositeCS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalCompositeCS, FThermalImageShader);
+
+	class FApplyNoise : SHADER_PERMUTATION_BOOL("APPLY_NOISE");
+	using FPermutationDomain = TShaderPermutationDomain<FApplyNoise>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, ColorTexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, NoiseTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, ImageSampler)
+		SHADER_PARAMETER(FIntPoint, OutputSize)
+		SHADER_PARAMETER(FVector2f, OutputInvSize)
+		SHADER_PARAMETER(float, NoiseAmount)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, RWOutput)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Output image into the override output of the post process chain, which can have any format and view rect
+class FThermalCopyPS : public FThermalImageShader
+{
+	DECLARE_GLOBAL_SHADER(FThermalCopyPS);
+	SHADER_USE_PARAMETER_STRUCT(FThermalCopyPS, FThermalImageShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, InputTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, InputSampler)
+		RENDER_TARGET_BINDING_SLOTS()
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+IMPLEMENT_GLOBAL_SHADER(FThermalClassifyCS, "/Plugin/Logi/Private/LogiThermalImage.usf", "ClassifyCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FThermalBlurCS, "/Plugin/Logi/Private/LogiThermalImage.usf", "BlurCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FThermalPaletteCS, "/Plugin/Logi/Private/LogiThermalImage.usf", "PaletteCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FThermalNoiseCS, "/Plugin/Logi/Private/LogiThermalImage.usf", "NoiseCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FThermalCompositeCS, "/Plugin/Logi/Private/LogiThermalImage.usf", "CompositeCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FThermalCopyPS, "/Plugin/Logi/Private/LogiThermalImage.usf", "CopyPS", SF_Pixel);
+
+FThermalSceneViewExtension::FThermalSceneViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld)
+	: FWorldSceneViewExtension(AutoRegister, InWorld)
+{
+}
+
+void FThermalSceneViewExtension::SetSettings(const FThermalImageSettings& InSettings)
+{
+	check(IsInGameThread());
+
+	GameThreadSettings = InSettings;
+
+	ENQUEUE_RENDER_COMMAND(SetThermalImageSettings)(
+		[Extension = StaticCastSharedRef<FThermalSceneViewExtension>(AsShared()), InSettings](FRHICommandListImmediate& RHICmdList) {
+			const FThermalImageSettings& Previous = Extension->RenderThreadSettings;
+			const bool bPaletteChanged = !Extension->PaletteTexture || Previous.Palette != InSettings.Palette
+				|| (InSettings.Palette == INDEX_NONE && (Previous.Cold != InSettings.Cold || Previous.Mid != InSettings.Mid || Previous.Hot != InSettings.Hot));
+
+			Extension->RenderThreadSettings = InSettings;
+
+			if (bPaletteChanged) {
+				Extension->UpdatePaletteTexture_RenderThread(RHICmdList);
+			}
+		});
+}
+
+void FThermalSceneViewExtension::UpdatePaletteTexture_RenderThread(FRHICommandListImmediate& RHICmdList)
+{
+	const FThermalImageSettings& Settings = RenderThreadSettings;
+
+	TArray<FColor, TFixedAllocator<ThermalPalettes::Width>> Colors;
+	Colors.SetNumUninitialized(ThermalPalettes::Width);
+
+	//The three colors of the controller are baked into the lookup as well, the palette pass always does a single fetch
+	if (Settings.Palette == INDEX_NONE) {
+		ThermalPalettes::GetThreeColorPaletteColors(Settings.Cold, Settings.Mid, Settings.Hot, Colors);
+	}
+	else {
+		ThermalPalettes::GetPaletteColors(FMath::Clamp(Settings.Palette, 0, ThermalPalettes::NumPalettes - 1), Colors);
+	}
+
+	if (!PaletteTexture) {
+		const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("Logi.ThermalPalette"), ThermalPalettes::Width, 1, PF_B8G8R8A8)
+			.SetFlags(ETextureCreateFlags::ShaderResource | ETextureCreateFlags::SRGB);
+
+		PaletteTexture = RHICreateTexture(Desc);
+	}
+
+	RHICmdList.UpdateTexture2D(PaletteTexture, 0, FUpdateTextureRegion2D(0, 0, 0, 0, ThermalPalettes::Width, 1), ThermalPalettes::Width * sizeof(FColor), reinterpret_cast<const uint8*>(Colors.GetData()));
+}
+
+bool FThermalSceneViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	return GameThreadSettings.bEnabled && FWorldSceneViewExtension::IsActiveThisFrame_Internal(Context);
+}
+
+void FThermalSceneViewExtension::SubscribeToPostProcessingPass(const EPostProcessingPass Pass, FAfterPassCallbackDelegateArray& InOutPassCallbacks, const bool bIsPassEnabled)
+{
+	//Same place in the frame as PP_Logi_ThermalCamera, which reads the tonemapped scene color
+	if (Pass == EPostProcessingPass::Tonemap) {
+		InOutPassCallbacks.Add(FAfterPassCallbackDelegate::CreateRaw(this, &FThermalSceneViewExtension::AddThermalImagePasses_RenderThread));
+	}
+}
+
+FScreenPassTexture FThermalSceneViewExtension::AddThermalImagePasses_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs)
+{
+	Inputs.Validate();
+
+	const FScreenPassTexture& SceneColor = Inputs.GetInput(EPostProcessMaterialInput::SceneColor);
+
+	//Settings can change between the game thread activating the extension and the frame rendering
+	if (!RenderThreadSettings.bEnabled || !SceneColor.IsValid() || !PaletteTexture) {
+		return Inputs.ReturnUntouchedSceneColorForPostProcessing(GraphBuilder);
+	}
+
+	const FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(View.GetFeatureLevel());
+	const FThermalImageSettings& Settings = RenderThreadSettings;
+
+	RDG_EVENT_SCOPE(GraphBuilder, "LogiThermalImage");
+	RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalImage);
+
+	const ERDGPassFlags ComputePassFlags = CVarThermalImageAsyncCompute.GetValueOnRenderThread() && GSupportsEfficientAsyncCompute ? ERDGPassFlags::AsyncCompute : ERDGPassFlags::Compute;
+
+	//The output covers the view rect of the tonemapped scene color, the intermediates the sensor. A sensor larger than the view would only add cost.
+	const FIntPoint OutputSize = SceneColor.ViewRect.Size();
+	const FIntPoint ImageSize = Settings.SensorResolution.X > 0 && Settings.SensorResolution.Y > 0 ? Settings.SensorResolution.ComponentMin(OutputSize) : OutputSize;
+	const FIntVector GroupCount = FComputeShaderUtils::GetGroupCount(ImageSize, ThermalImageGroupSize);
+
+	const FRDGTextureDesc TemperatureDesc = FRDGTextureDesc::Create2D(ImageSize, PF_R16F, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+	const FRDGTextureDesc ColorDesc = FRDGTextureDesc::Create2D(ImageSize, PF_FloatRGBA, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+
+	FRDGTextureRef Temperature = GraphBuilder.CreateTexture(TemperatureDesc, TEXT("Logi.ThermalTemperature"));
+
+	{
+		RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalClassify);
+
+		FThermalClassifyCS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalClassifyCS::FParameters>();
+		Parameters->View = View.ViewUniformBuffer;
+		Parameters->SceneTextures = Inputs.SceneTextures.SceneTextures;
+		Parameters->SceneColorTexture = SceneColor.Texture;
+		Parameters->SceneColorViewMin = SceneColor.ViewRect.Min;
+		Parameters->SceneColorViewSize = OutputSize;
+		Parameters->ImageSize = ImageSize;
+		Parameters->ImageInvSize = FVector2f(1.0f / ImageSize.X, 1.0f / ImageSize.Y);
+		Parameters->BackgroundTemperature = Settings.BackgroundTemperature;
+		Parameters->SkyTemperature = Settings.SkyTemperature;
+		Parameters->FresnelExponent = FresnelExponent;
+		Parameters->RWTemperature = GraphBuilder.CreateUAV(Temperature);
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Classify %dx%d", ImageSize.X, ImageSize.Y), ComputePassFlags,
+			TShaderMapRef<FThermalClassifyCS>(ShaderMap), Parameters, GroupCount);
+	}
+
+	//The radius is in display pixels so the sensor resolution does not change how blurred the image looks
+	const float BlurRadius = FMath::Clamp(Settings.Blur, 0.0f, 1.0f) * MaxBlurRadius * ImageSize.X / OutputSize.X;
+	const int32 BlurTaps = FMath::CeilToInt32(BlurRadius);
+
+	if (BlurTaps > 0) {
+		RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalBlur);
+
+		//Gaussian over 3 sigma of the radius, each pass reads every texel of its row or column once per tap
+		const float Sigma = FMath::Max(BlurRadius / 3.0f, 0.3f);
+		FRDGTextureRef BlurredX = GraphBuilder.CreateTexture(TemperatureDesc, TEXT("Logi.ThermalTemperatureBlurX"));
+
+		const auto AddBlurPass = [&](FRDGTextureRef Source, FRDGTextureRef Destination, const FIntPoint Direction) {
+			FThermalBlurCS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalBlurCS::FParameters>();
+			Parameters->TemperatureTexture = Source;
+			Parameters->ImageSize = ImageSize;
+			Parameters->BlurDirection = Direction;
+			Parameters->BlurTaps = BlurTaps;
+			Parameters->BlurInvTwoSigmaSquared = 0.5f / (Sigma * Sigma);
+			Parameters->RWTemperature = GraphBuilder.CreateUAV(Destination);
+
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Blur %s (%d taps)", Direction.X ? TEXT("X") : TEXT("Y"), BlurTaps * 2 + 1), ComputePassFlags,
+				TShaderMapRef<FThermalBlurCS>(ShaderMap), Parameters, GroupCount);
+		};
+
+		//The vertical pass writes back into the classified temperature, it is not read after the horizontal pass
+		AddBlurPass(Temperature, BlurredX, FIntPoint(1, 0));
+		AddBlurPass(BlurredX, Temperature, FIntPoint(0, 1));
+	}
+
+	FRDGTextureRef Color = GraphBuilder.CreateTexture(ColorDesc, TEXT("Logi.ThermalColor"));
+
+	{
+		RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalPalette);
+
+		FThermalPaletteCS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalPaletteCS::FParameters>();
+		Parameters->TemperatureTexture = Temperature;
+		Parameters->PaletteTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(PaletteTexture, TEXT("Logi.ThermalPalette")));
+		Parameters->PaletteSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp>::GetRHI();
+		Parameters->ImageSize = ImageSize;
+		Parameters->RWColor = GraphBuilder.CreateUAV(Color);
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Palette"), ComputePassFlags,
+			TShaderMapRef<FThermalPaletteCS>(ShaderMap), Parameters, GroupCount);
+	}
+
+	const bool bApplyNoise = Settings.NoiseAmount > 0.0f;
+	FRDGTextureRef Noise = nullptr;
+
+	if (bApplyNoise) {
+		RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalNoise);
+
+		Noise = GraphBuilder.CreateTexture(TemperatureDesc, TEXT("Logi.ThermalNoise"));
+
+		//The texture may still be streaming in or compiling, hash noise until it has an RHI texture
+		FRHITexture* BlueNoiseRHI = nullptr;
+
+		if (Settings.bBlueNoise && Settings.BlueNoiseTexture) {
+			if (const FTextureResource* Resource = Settings.BlueNoiseTexture->GetResource()) {
+				BlueNoiseRHI = Resource->TextureRHI;
+			}
+		}
+
+		FThermalNoiseCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FThermalNoiseCS::FBlueNoise>(BlueNoiseRHI != nullptr);
+
+		FThermalNoiseCS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalNoiseCS::FParameters>();
+		Parameters->View = View.ViewUniformBuffer;
+		Parameters->ImageSize = ImageSize;
+		Parameters->NoiseSize = Settings.NoiseSize;
+		Parameters->RWNoise = GraphBuilder.CreateUAV(Noise);
+
+		if (BlueNoiseRHI) {
+			Parameters->BlueNoiseTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(BlueNoiseRHI, TEXT("Logi.ThermalBlueNoise")));
+			Parameters->BlueNoiseSize = BlueNoiseRHI->GetSizeXY();
+		}
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Noise %s", BlueNoiseRHI ? TEXT("BlueNoise") : TEXT("Hash")), ComputePassFlags,
+			TShaderMapRef<FThermalNoiseCS>(ShaderMap, PermutationVector), Parameters, GroupCount);
+	}
+
+	const FRDGTextureDesc ImageDesc = FRDGTextureDesc::Create2D(OutputSize, PF_FloatRGBA, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+	FRDGTextureRef Image = GraphBuilder.CreateTexture(ImageDesc, TEXT("Logi.ThermalImage"));
+
+	{
+		RDG_GPU_STAT_SCOPE(GraphBuilder, LogiThermalComposite);
+
+		FThermalCompositeCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FThermalCompositeCS::FApplyNoise>(bApplyNoise);
+
+		FThermalCompositeCS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalCompositeCS::FParameters>();
+		Parameters->ColorTexture = Color;
+		Parameters->NoiseTexture = Noise;
+		Parameters->ImageSampler = Settings.bBilinearUpscale ? TStaticSamplerState<SF_Bilinear>::GetRHI() : TStaticSamplerState<SF_Point>::GetRHI();
+		Parameters->OutputSize = OutputSize;
+		Parameters->OutputInvSize = FVector2f(1.0f / OutputSize.X, 1.0f / OutputSize.Y);
+		Parameters->NoiseAmount = Settings.NoiseAmount;
+		Parameters->RWOutput = GraphBuilder.CreateUAV(Image);
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Composite %dx%d -> %dx%d", ImageSize.X, ImageSize.Y, OutputSize.X, OutputSize.Y), ComputePassFlags,
+			TShaderMapRef<FThermalCompositeCS>(ShaderMap, PermutationVector), Parameters, FComputeShaderUtils::GetGroupCount(OutputSize, ThermalImageGroupSize));
+	}
+
+	const FScreenPassTexture ThermalImage(Image, FIntRect(FIntPoint::ZeroValue, OutputSize));
+
+	//The last pass of the chain has to write into the target the post process chain gives it.
+	//A draw rather than a copy, the target is usually the back buffer with its own format.
+	if (Inputs.OverrideOutput.IsValid()) {
+		FThermalCopyPS::FParameters* Parameters = GraphBuilder.AllocParameters<FThermalCopyPS::FParameters>();
+		Parameters->InputTexture = ThermalImage.Texture;
+		Parameters->InputSampler = TStaticSamplerState<SF_Point>::GetRHI();
+		Parameters->RenderTargets[0] = Inputs.OverrideOutput.GetRenderTargetBinding();
+
+		AddDrawScreenPass(GraphBuilder, RDG_EVENT_NAME("Copy %dx%d", OutputSize.X, OutputSize.Y), View,
+			FScreenPassTextureViewport(Inputs.OverrideOutput), FScreenPassTextureViewport(ThermalImage),
+			TShaderMapRef<FThermalCopyPS>(ShaderMap), Parameters);
+
+		return FScreenPassTexture(Inputs.OverrideOutput);
+	}
+
+	return ThermalImage;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Built in palettes of the thermal image, one row each of the T_Logi_ThermalPalettes atlas and the lookup texture of the scene view extension.
+// Both are indexed by the normalized temperature, 0 at the left edge and 1 at the right.
+namespace ThermalPalettes
+{
+	// Entries of one palette
+	constexpr int32 Width = 256;
+
+	// Rows of the atlas, in order: iron, rainbow, white hot, black hot
+	constexpr int32 NumPalettes = 4;
+
+	// sRGB colors of one built in palette, OutColors has Width entries
+	LOGIRENDERING_API void GetPaletteColors(int32 Palette, TArrayView<FColor> OutColors);
+
+	// The same three stop blend as the engine 3ColorBlend, cold at 0, mid at 0.5 and hot at 1
+	LOGIRENDERING_API void GetThreeColorPaletteColors(const FLinearColor& Cold, const FLinearColor& Mid, const FLinearColor& Hot, TArrayView<FColor> OutColors);
+}
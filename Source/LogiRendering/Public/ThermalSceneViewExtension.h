@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneViewExtension.h"
+
+struct FPostProcessMaterialInputs;
+struct FScreenPassTexture;
+class UTexture;
+
+// Thermal camera settings of the controller, normalized the same way they are written to MPC_Logi_ThermalSettings
+struct LOGIRENDERING_API FThermalImageSettings
+{
+	bool bEnabled = false;
+
+	float BackgroundTemperature = 0.0f;
+	float SkyTemperature = 0.0f;
+
+	// Size the temperature, palette and noise are formed at before the upscale to the view, 0 forms them at display resolution
+	FIntPoint SensorResolution = FIntPoint::ZeroValue;
+	bool bBilinearUpscale = false;
+
+	// 0-1, full Blur is a Gaussian radius of 32 display pixels
+	float Blur = 0.0f;
+
+	float NoiseAmount = 0.0f;
+
+	// Noise cells per sensor pixel
+	float NoiseSize = 1.0f;
+
+	// Tiles BlueNoiseTexture over the noise cells instead of hashing them, falls back to the hash while the texture has no resource
+	bool bBlueNoise = false;
+
+	// Kept alive by the owner of the settings, the render thread only reads its resource
+	UTexture* BlueNoiseTexture = nullptr;
+
+	// Built in palette of ThermalPalettes, INDEX_NONE blends Cold, Mid and Hot
+	int32 Palette = INDEX_NONE;
+
+	FLinearColor Cold = FLinearColor::Blue;
+	FLinearColor Mid = FLinearColor::Yellow;
+	FLinearColor Hot = FLinearColor::Red;
+};
+
+/**
+ * Forms the thermal image of one world natively, replacing PP_Logi_ThermalCamera. Runs after the tonemapper as a chain of
+ * compute passes with their own RDG textures: classify (scene to normalized temperature), a separable blur of the temperature,
+ * palette lookup and sensor noise at the sensor resolution, then a composite that upscales them to the view. Every pass has its own
+ * GPU stat, and the passes can run on async compute (Logi.Thermal.Image.*).
+ */
+class LOGIRENDERING_API FThermalSceneViewExtension : public FWorldSceneViewExtension
+{
+public:
+	FThermalSceneViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld);
+
+	// Game thread, the render thread picks the settings up with the next frame
+	void SetSettings(const FThermalImageSettings& InSettings);
+
+	//~ ISceneViewExtension interface
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SubscribeToPostProcessingPass(EPostProcessingPass Pass, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled) override;
+
+protected:
+	virtual bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
+
+private:
+	FScreenPassTexture AddThermalImagePasses_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs);
+
+	// Writes the palette of the render thread settings into PaletteTexture, creating it on first use
+	void UpdatePaletteTexture_RenderThread(FRHICommandListImmediate& RHICmdList);
+
+	FThermalImageSettings GameThreadSettings;
+	FThermalImageSettings RenderThreadSettings;
+
+	// ThermalPalettes::Width x 1 lookup of the current palette, only rewritten when the palette changes
+	FTextureRHIRef PaletteTexture;
+};
@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LogiRuntime.h"
+
+#define LOCTEXT_NAMESPACE "FLogiRuntimeModule"
+
+void FLogiRuntimeModule::StartupModule()
+{
+	// Runtime side of Logi. Everything that has to run in packaged games (thermal actor updates, controller logic) lives here,
+	// the Editor-only Logi module only generates assets and patches blueprints.
+}
+
+void FLogiRuntimeModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FLogiRuntimeModule, LogiRuntime)
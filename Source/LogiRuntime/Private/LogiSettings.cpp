@@ -0,0 +1,37 @@
+#include "LogiSettings.h"
+
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInterface.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "RHI.h"
+
+ULogiSettings::ULogiSettings()
+{
+	ThermalMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial.M_Logi_ThermalMaterial")));
+	CustomPrimitiveDataThermalMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial_CPD.M_Logi_ThermalMaterial_CPD")));
+	InstancedThermalMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial_Instanced.M_Logi_ThermalMaterial_Instanced")));
+	SkeletalThermalMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Logi_ThermalCamera/Materials/M_Logi_ThermalMaterial_Skeletal.M_Logi_ThermalMaterial_Skeletal")));
+	BlueNoiseTexture = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Engine/EngineMaterials/Good64x64TilingNoiseHighFreq.Good64x64TilingNoiseHighFreq")));
+}
+
+FName ULogiSettings::GetCategoryName() const
+{
+	return FName(TEXT("Plugins"));
+}
+
+TSoftObjectPtr<UMaterialInterface> ULogiSettings::GetThermalMaterial() const
+{
+	return UseCustomPrimitiveData() ? CustomPrimitiveDataThermalMaterial : ThermalMaterial;
+}
+
+bool ULogiSettings::UseThermalImageExtension() const
+{
+	return ThermalImageMode == EThermalImageMode::SceneViewExtension && GMaxRHIFeatureLevel >= ERHIFeatureLevel::SM5;
+}
+
+const FThermalMaterialClass* ULogiSettings::FindThermalMaterialClass(const UPhysicalMaterial* PhysicalMaterial) const
+{
+	if (!PhysicalMaterial || ThermalMaterialClasses.Num() == 0) return nullptr;
+
+	return ThermalMaterialClasses.Find(TSoftObjectPtr<UPhysicalMaterial>(FSoftObjectPath(PhysicalMaterial)));
+}
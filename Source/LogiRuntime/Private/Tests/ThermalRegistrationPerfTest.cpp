@@ -0,0 +1,62 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Tests/ThermalTestWorld.h"
+
+namespace
+{
+	constexpr int32 NumActors = 10000;
+
+	// Registers NumActors thermal components with the controller registered before or after them, returns the seconds it took
+	double TimeRegistration(FAutomationTestBase& Test, const bool bControllerFirst)
+	{
+		const FThermalTestWorld TestWorld;
+		UThermalWorldSubsystem* Subsystem = TestWorld.GetSubsystem();
+
+		TArray<UThermalComponent*> Components;
+		Components.Reserve(NumActors);
+		for (int32 Index = 0; Index < NumActors; ++Index) {
+			Components.Add(TestWorld.CreateComponent(FGuid::NewGuid(), 20.0f, static_cast<float>(Index % 100), 100.0f));
+		}
+
+		AThermalController* Controller = TestWorld.World->SpawnActor<AThermalController>();
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		if (bControllerFirst) {
+			Subsystem->RegisterThermalController(Controller);
+		}
+		for (UThermalComponent* Component : Components) {
+			Subsystem->RegisterThermalComponent(Component);
+		}
+		if (!bControllerFirst) {
+			Subsystem->RegisterThermalController(Controller);
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+		Test.TestEqual(TEXT("Registered thermal components"), Subsystem->GetNumThermalComponents(), NumActors);
+		Test.TestFalse(TEXT("A component is missing the controller"), Components.ContainsByPredicate([Controller](const UThermalComponent* Component)
+		{
+			return Component->GetThermalController() != Controller;
+		}));
+
+		return Seconds;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalRegistrationPerfTest, "Logi.Thermal.Perf.Registration",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalRegistrationPerfTest::RunTest(const FString& Parameters)
+{
+	const double ControllerFirstSeconds = TimeRegistration(*this, true);
+	const double ControllerLastSeconds = TimeRegistration(*this, false);
+
+	AddInfo(FString::Printf(TEXT("Registering %d thermal components: %.3f ms with the controller registered first, %.3f ms with the controller registered last"),
+		NumActors, ControllerFirstSeconds * 1000.0, ControllerLastSeconds * 1000.0));
+
+	return true;
+}
+
+#endif
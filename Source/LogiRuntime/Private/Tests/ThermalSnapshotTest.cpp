@@ -0,0 +1,111 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Curves/CurveFloat.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/ThermalTestWorld.h"
+#include "ThermalProfile.h"
+
+namespace
+{
+	// "LOGT", the first bytes of every thermal snapshot
+	constexpr uint32 SnapshotMagic = 0x4C4F4754;
+
+	// Header of a snapshot as SaveThermalSnapshot writes it, followed by nothing
+	TArray<uint8> MakeSnapshotHeader(uint32 Magic, int32 Version, int32 NumEntries)
+	{
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+
+		int64 SimulatedSteps = 0;
+		float TimeAccumulator = 0.0f;
+		float RangeMin = 0.0f;
+		float RangeMax = 100.0f;
+		Writer << Magic << Version << NumEntries << SimulatedSteps << TimeAccumulator << RangeMin << RangeMax;
+
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalSnapshotRoundTripTest, "Logi.Thermal.Snapshot.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FThermalSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FThermalTestWorld TestWorld;
+	UThermalWorldSubsystem* Subsystem = TestWorld.GetSubsystem();
+	if (!TestNotNull(TEXT("Thermal world subsystem"), Subsystem)) return false;
+
+	const FGuid KeptGuid = FGuid::NewGuid();
+	const FGuid RemovedGuid = FGuid::NewGuid();
+	UThermalComponent* Kept = TestWorld.AddComponent(KeptGuid, 12.3f, 45.6f, 78.9f);
+	UThermalComponent* Removed = TestWorld.AddComponent(RemovedGuid, -20.0f, 0.0f, 20.0f);
+
+	//A profile that ramps from base to max temperature over 10 seconds, created at runtime so it is baked on first play
+	UThermalProfile* Profile = NewObject<UThermalProfile>();
+	Profile->Curve = NewObject<UCurveFloat>(Profile);
+	Profile->Curve->FloatCurve.AddKey(0.0f, 0.0f);
+	Profile->Curve->FloatCurve.AddKey(10.0f, 1.0f);
+	Kept->PlayThermalProfile(Profile);
+
+	//Run a few frames on the game thread, 0.07 seconds do not fit a whole number of fixed steps
+	const FThermalScopedCVar Async(TEXT("Logi.Thermal.Transient.Async"), TEXT("0"));
+	const FThermalScopedCVar Hz(TEXT("Logi.Thermal.Transient.Hz"), TEXT("30"));
+	TestWorld.AddController();
+	for (int32 Frame = 0; Frame < 7; ++Frame) {
+		Subsystem->Tick(0.01f);
+	}
+
+	const float SavedProfileTime = Subsystem->GetProfileTime(*Kept);
+	const int64 SavedSteps = Subsystem->GetSimulatedSteps();
+	const float SavedTimeAccumulator = Subsystem->GetTransientTimeAccumulator();
+	const float SavedCurrentTemperature = Kept->GetCurrentTemperature();
+	TestTrue(TEXT("Profile has played"), SavedProfileTime > 0.0f);
+	TestTrue(TEXT("Steps have been simulated"), SavedSteps > 0);
+
+	TArray<uint8> Data;
+	Subsystem->SaveThermalSnapshot(Data);
+
+	//Move the simulation on, change the saved component, drop the other one and add one the snapshot does not know
+	for (int32 Frame = 0; Frame < 5; ++Frame) {
+		Subsystem->Tick(0.01f);
+	}
+	Kept->SetCurrentTemperature(99.0f);
+	Subsystem->UnregisterThermalComponent(Removed);
+	UThermalComponent* Added = TestWorld.AddComponent(FGuid::NewGuid(), 1.0f, 2.0f, 3.0f);
+
+	TestTrue(TEXT("Restore succeeds with a missing entry"), Subsystem->RestoreThermalSnapshot(Data));
+
+	//One 16 bit step over the range of the whole snapshot, -20 to 78.9, rounded to the nearest step
+	const float Tolerance = (78.9f + 20.0f) / MAX_uint16 * 0.5f + UE_KINDA_SMALL_NUMBER;
+	TestNearlyEqual(TEXT("Restored base temperature"), Kept->GetThermalState().BaseTemperature, 12.3f, Tolerance);
+	TestNearlyEqual(TEXT("Restored current temperature"), Kept->GetCurrentTemperature(), SavedCurrentTemperature, Tolerance);
+	TestNearlyEqual(TEXT("Restored max temperature"), Kept->GetThermalState().MaxTemperature, 78.9f, Tolerance);
+	TestEqual(TEXT("Component missing from the snapshot keeps its temperature"), Added->GetCurrentTemperature(), 2.0f);
+
+	//The profile continues where it was saved, and the next frame steps from the saved simulation time
+	TestEqual(TEXT("Restored profile time"), Subsystem->GetProfileTime(*Kept), SavedProfileTime);
+	TestEqual(TEXT("Restored simulated steps"), Subsystem->GetSimulatedSteps(), SavedSteps);
+	TestEqual(TEXT("Restored time accumulator"), Subsystem->GetTransientTimeAccumulator(), SavedTimeAccumulator);
+
+	//Every rejected snapshot leaves the state alone
+	AddExpectedError(TEXT("Failed to restore the thermal snapshot"), EAutomationExpectedErrorFlags::Contains, 5);
+
+	TArray<uint8> WrongMagic = Data;
+	WrongMagic[0] ^= 0xFF;
+	TestFalse(TEXT("Wrong magic is rejected"), Subsystem->RestoreThermalSnapshot(WrongMagic));
+	TestFalse(TEXT("Unknown version is rejected"), Subsystem->RestoreThermalSnapshot(MakeSnapshotHeader(SnapshotMagic, 1000, 0)));
+	TestFalse(TEXT("Negative entry count is rejected"), Subsystem->RestoreThermalSnapshot(MakeSnapshotHeader(SnapshotMagic, 1, -1)));
+	TestFalse(TEXT("Entry count larger than the data is rejected"), Subsystem->RestoreThermalSnapshot(MakeSnapshotHeader(SnapshotMagic, 1, MAX_int32)));
+
+	TArray<uint8> Truncated = Data;
+	Truncated.SetNum(Data.Num() - 1);
+	TestFalse(TEXT("Truncated snapshot is rejected"), Subsystem->RestoreThermalSnapshot(Truncated));
+
+	TestNearlyEqual(TEXT("Rejected snapshots keep the restored temperature"), Kept->GetCurrentTemperature(), SavedCurrentTemperature, Tolerance);
+
+	return true;
+}
+
+#endif
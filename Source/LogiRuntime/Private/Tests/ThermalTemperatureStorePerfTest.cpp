@@ -0,0 +1,268 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Math/RandomStream.h"
+#include "ThermalAmbientVolume.h"
+#include "ThermalSpatialHash.h"
+#include "ThermalTemperatureStore.h"
+
+namespace
+{
+	// Fixed seed, so every run measures the same values
+	constexpr int32 RandomSeed = 0x4C4F4749;
+
+	// Variance of the published temperatures, heat exchange lowers it
+	double GetTemperatureVariance(const FThermalTemperatureStore& Store)
+	{
+		const TConstArrayView<float> Temperatures = Store.GetCurrentTemperatures();
+		double Sum = 0.0;
+		double SquaredSum = 0.0;
+		for (const float Temperature : Temperatures) {
+			Sum += Temperature;
+			SquaredSum += static_cast<double>(Temperature) * Temperature;
+		}
+		const double Mean = Sum / Temperatures.Num();
+		return SquaredSum / Temperatures.Num() - Mean * Mean;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalNormalizePerfTest, "Logi.Thermal.Perf.Normalize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalNormalizePerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumValues = 100000;
+	constexpr int32 NumIterations = 100;
+	constexpr float RangeMin = -20.0f;
+	constexpr float RangeMax = 120.0f;
+
+	//Values around and outside of the range, both paths extrapolate the same way
+	FRandomStream Random(RandomSeed);
+	TArray<float> Values;
+	Values.SetNumUninitialized(NumValues);
+	for (float& Value : Values) {
+		Value = Random.FRandRange(-50.0f, 150.0f);
+	}
+
+	TArray<float> KismetValues;
+	KismetValues.SetNumUninitialized(NumValues);
+	double StartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration) {
+		for (int32 Index = 0; Index < NumValues; ++Index) {
+			KismetValues[Index] = UKismetMathLibrary::NormalizeToRange(Values[Index], RangeMin, RangeMax);
+		}
+	}
+	const double KismetSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumIterations;
+
+	TArray<float> StoreValues;
+	StoreValues.SetNumUninitialized(NumValues);
+	StartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration) {
+		FThermalTemperatureStore::NormalizeToRange(Values.GetData(), StoreValues.GetData(), NumValues, RangeMin, RangeMax);
+	}
+	const double StoreSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumIterations;
+
+	float MaxError = 0.0f;
+	for (int32 Index = 0; Index < NumValues; ++Index) {
+		MaxError = FMath::Max(MaxError, FMath::Abs(KismetValues[Index] - StoreValues[Index]));
+	}
+
+	AddInfo(FString::Printf(TEXT("Normalizing %d values: UKismetMathLibrary %.3f ms, temperature store %.3f ms, max difference %g"),
+		NumValues, KismetSeconds * 1000.0, StoreSeconds * 1000.0, MaxError));
+
+	//The store multiplies by the reciprocal of the range instead of dividing, which only changes the rounding
+	TestTrue(TEXT("Normalized values match UKismetMathLibrary::NormalizeToRange"), MaxError <= UE_KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalSimulatePerfTest, "Logi.Thermal.Perf.Simulate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalSimulatePerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSteps = 100;
+	constexpr float StepSeconds = 1.0f / 30.0f;
+
+	for (const int32 NumEntries : {1000, 10000, 100000}) {
+		//Half of the entries heat up and half cool down, the time constants are long enough that none settles while measured
+		FRandomStream Random(RandomSeed);
+		FThermalTemperatureStore Store;
+		for (int32 Index = 0; Index < NumEntries; ++Index) {
+			Store.Add(20.0f, Random.FRandRange(20.0f, 90.0f), 100.0f);
+			Store.SetTransient(Index, Random.FRandRange(30.0f, 60.0f), Random.FRandRange(60.0f, 120.0f), (Index & 2) != 0);
+			Store.SetActive(Index, (Index & 1) != 0);
+		}
+		Store.Publish();
+		const float FirstTemperature = Store.GetCurrent(1);
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < NumSteps; ++Step) {
+			Store.Simulate(StepSeconds, 10.0f);
+		}
+		const double SecondsPerStep = (FPlatformTime::Seconds() - StartSeconds) / NumSteps;
+
+		Store.Publish();
+
+		AddInfo(FString::Printf(TEXT("Simulating %d transient entries: %.3f ms per step, %.2f ns per entry"),
+			NumEntries, SecondsPerStep * 1000.0, SecondsPerStep * 1.0e9 / NumEntries));
+
+		TestTrue(TEXT("Active entries heat up"), Store.GetCurrent(1) > FirstTemperature && Store.GetCurrent(1) < 100.0f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalHeatExchangePerfTest, "Logi.Thermal.Perf.HeatExchange",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalHeatExchangePerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSteps = 30;
+	constexpr float StepSeconds = 1.0f / 30.0f;
+	constexpr float Radius = 500.0f;
+	constexpr float Coefficient = 0.1f;
+	constexpr int32 MaxNeighbours = 8;
+
+	//About one entry per 3.2 m cube, so every entry has more neighbours within the radius than it exchanges heat with
+	constexpr float Spacing = 320.0f;
+
+	for (const int32 NumEntries : {5000, 10000, 25000, 50000}) {
+		FRandomStream Random(RandomSeed);
+		FThermalTemperatureStore Store;
+		FThermalSpatialHash SpatialHash;
+		SpatialHash.SetCellSize(Radius);
+
+		//The density stays the same as the entries are added, so the time per entry should too
+		const float Extent = FMath::Pow(static_cast<float>(NumEntries), 1.0f / 3.0f) * Spacing;
+		for (int32 Index = 0; Index < NumEntries; ++Index) {
+			Store.Add(20.0f, Random.FRandRange(0.0f, 100.0f), 100.0f);
+			SpatialHash.Add();
+			SpatialHash.Update(Index, FVector(Random.FRandRange(0.0f, Extent), Random.FRandRange(0.0f, Extent), Random.FRandRange(0.0f, Extent)));
+		}
+		Store.Publish();
+		const double VarianceBefore = GetTemperatureVariance(Store);
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < NumSteps; ++Step) {
+			Store.ExchangeHeat(SpatialHash, StepSeconds, Radius, Coefficient, MaxNeighbours);
+		}
+		const double SecondsPerStep = (FPlatformTime::Seconds() - StartSeconds) / NumSteps;
+
+		Store.Publish();
+
+		AddInfo(FString::Printf(TEXT("Exchanging heat between %d entries: %.3f ms per step, %.2f ns per entry"),
+			NumEntries, SecondsPerStep * 1000.0, SecondsPerStep * 1.0e9 / NumEntries));
+
+		TestTrue(TEXT("Heat exchange evens out the temperatures"), GetTemperatureVariance(Store) < VarianceBefore);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalSolarPerfTest, "Logi.Thermal.Perf.Solar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalSolarPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumEntries = 10000;
+	constexpr int32 NumPasses = 100;
+	constexpr float Intensity = 20.0f;
+
+	//Sunlit props facing random directions, one of them is a vehicle that turns on its own
+	FRandomStream Random(RandomSeed);
+	FThermalTemperatureStore Store;
+	for (int32 Index = 0; Index < NumEntries; ++Index) {
+		Store.Add(20.0f, 20.0f, 100.0f);
+		Store.SetSolar(Index, Random.FRandRange(0.1f, 1.0f), FVector3f(Random.GetUnitVector()));
+	}
+	Store.Publish();
+
+	//The sun moves between the passes, so every pass has heating to write
+	double StartSeconds = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass) {
+		const float SunAngle = FMath::DegreesToRadians(10.0f + Pass);
+		Store.ApplySolarHeating(FVector3f(FMath::Cos(SunAngle), 0.0f, FMath::Sin(SunAngle)), Intensity);
+	}
+	const double FullSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumPasses;
+
+	//The sun stands still while the vehicle turns toward and away from it
+	const FVector3f DirectionToSun = FVector3f::UpVector;
+	Store.ApplySolarHeating(DirectionToSun, Intensity);
+
+	const TArray<int32> TurnedIndices = {0};
+	StartSeconds = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass) {
+		Store.SetSolarNormal(0, (Pass & 1) ? FVector3f::UpVector : FVector3f::ForwardVector, 0.0f);
+		Store.ApplySolarHeating(TurnedIndices, DirectionToSun, Intensity);
+	}
+	const double TurnedSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumPasses;
+
+	AddInfo(FString::Printf(TEXT("Solar heating of %d entries: %.3f ms per pass, %.2f ns per entry. One turned entry: %.4f ms per pass"),
+		NumEntries, FullSeconds * 1000.0, FullSeconds * 1.0e9 / NumEntries, TurnedSeconds * 1000.0));
+
+	//The last turn faced the vehicle up at the sun, a full pass gives it the same heating
+	const float TurnedHeat = Store.GetSurfaceCurrent(0) - Store.GetCurrent(0);
+	Store.ApplySolarHeating(DirectionToSun, Intensity);
+	TestNearlyEqual(TEXT("Turned entry heating matches a full pass"), TurnedHeat, Store.GetSurfaceCurrent(0) - Store.GetCurrent(0), UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("One turned entry costs less than a full pass"), TurnedSeconds < FullSeconds);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalAmbientSamplingPerfTest, "Logi.Thermal.Perf.AmbientSampling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalAmbientSamplingPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumEntries = 10000;
+	constexpr int32 NumPasses = 100;
+	constexpr float Radius = 400.0f;
+	constexpr float Extent = 5000.0f;
+
+	//A few warm and cold pockets far enough apart not to overlap, e.g. interiors and a cellar
+	const TArray<FVector> Centers = {FVector(1000.0f, 1000.0f, 200.0f), FVector(4000.0f, 1000.0f, 200.0f), FVector(2500.0f, 4000.0f, -300.0f)};
+	const TArray<float> Offsets = {8.0f, 12.0f, -6.0f};
+
+	FThermalAmbientVolume AmbientVolume;
+	for (int32 Stamp = 0; Stamp < Centers.Num(); ++Stamp) {
+		AmbientVolume.Stamp(Centers[Stamp], Radius, Offsets[Stamp]);
+	}
+	const int32 NumStampedBricks = AmbientVolume.NumBricks();
+	TestTrue(TEXT("Stamps allocate bricks"), NumStampedBricks > 0);
+	TestNearlyEqual(TEXT("Offset at the center of a stamp"), AmbientVolume.Sample(FVector3f(Centers[0])), Offsets[0], 0.5f);
+
+	//Entries spread over the level, most of them outside the pockets
+	FRandomStream Random(RandomSeed);
+	FThermalTemperatureStore Store;
+	TArray<FVector3f> Locations;
+	Locations.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries; ++Index) {
+		Store.Add(20.0f, 20.0f, 100.0f);
+		Store.SetTransient(Index, 30.0f, 60.0f, true);
+		Locations.Add(FVector3f(Random.FRandRange(0.0f, Extent), Random.FRandRange(0.0f, Extent), Random.FRandRange(-500.0f, 500.0f)));
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass) {
+		Store.SampleAmbient(AmbientVolume, Locations);
+	}
+	const double SecondsPerPass = (FPlatformTime::Seconds() - StartSeconds) / NumPasses;
+
+	AddInfo(FString::Printf(TEXT("Sampling %d bricks at %d locations: %.3f ms per pass, %.2f ns per location"),
+		NumStampedBricks, NumEntries, SecondsPerPass * 1000.0, SecondsPerPass * 1.0e9 / NumEntries));
+
+	//Stamps of opposite sign give the bricks back
+	for (int32 Stamp = 0; Stamp < Centers.Num(); ++Stamp) {
+		AmbientVolume.Stamp(Centers[Stamp], Radius, -Offsets[Stamp]);
+	}
+	TestEqual(TEXT("Cancelling stamps free every brick"), AmbientVolume.NumBricks(), 0);
+	TestTrue(TEXT("Volume is empty after cancelling stamps"), AmbientVolume.IsEmpty());
+
+	return true;
+}
+
+#endif
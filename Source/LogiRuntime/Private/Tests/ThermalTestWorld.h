@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "ThermalComponent.h"
+#include "ThermalControllerActor.h"
+#include "ThermalWorldSubsystem.h"
+
+// Game world with a thermal world subsystem, destroyed with the test. The world does not begin play,
+// components and controllers are registered with the subsystem the way their BeginPlay would.
+struct FThermalTestWorld
+{
+	FThermalTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+	}
+
+	~FThermalTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UThermalWorldSubsystem* GetSubsystem() const { return World->GetSubsystem<UThermalWorldSubsystem>(); }
+
+	// Thermal controller registered with the subsystem
+	AThermalController* AddController() const
+	{
+		AThermalController* Controller = World->SpawnActor<AThermalController>();
+		GetSubsystem()->RegisterThermalController(Controller);
+		return Controller;
+	}
+
+	// Thermal component with the given key and temperatures on an actor of its own, not registered with the subsystem yet
+	UThermalComponent* CreateComponent(const FGuid& Guid, const float BaseTemperature, const float CurrentTemperature, const float MaxTemperature) const
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		UThermalComponent* Component = NewObject<UThermalComponent>(Actor);
+		Component->RegisterComponent();
+		Component->SetThermalGuid(Guid);
+		Component->SetBaseTemperature(BaseTemperature);
+		Component->SetMaxTemperature(MaxTemperature);
+		Component->SetCurrentTemperature(CurrentTemperature);
+		return Component;
+	}
+
+	// Registered thermal component with the given key and temperatures
+	UThermalComponent* AddComponent(const FGuid& Guid, const float BaseTemperature, const float CurrentTemperature, const float MaxTemperature) const
+	{
+		UThermalComponent* Component = CreateComponent(Guid, BaseTemperature, CurrentTemperature, MaxTemperature);
+		GetSubsystem()->RegisterThermalComponent(Component);
+		return Component;
+	}
+
+	UWorld* World = nullptr;
+};
+
+// Sets a console variable for the lifetime of a test, e.g. to measure without the frame budget
+struct FThermalScopedCVar
+{
+	FThermalScopedCVar(const TCHAR* Name, const TCHAR* Value)
+		: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+	{
+		if (Variable) {
+			OldValue = Variable->GetString();
+			Variable->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	~FThermalScopedCVar()
+	{
+		if (Variable) {
+			Variable->Set(*OldValue, ECVF_SetByCode);
+		}
+	}
+
+	IConsoleVariable* Variable = nullptr;
+	FString OldValue;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/StaticMeshComponent.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "LogiSettings.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/ScopeExit.h"
+#include "Tests/ThermalTestWorld.h"
+
+namespace
+{
+	constexpr int32 NumFrames = 60;
+	constexpr float FrameSeconds = 1.0f / 60.0f;
+
+	// Thermal actor with a mesh that begins play, so it gets its own dynamic material instance and registers with the subsystem
+	UThermalComponent* SpawnThermalActor(const FThermalTestWorld& TestWorld, const float CurrentTemperature)
+	{
+		AActor* Actor = TestWorld.World->SpawnActor<AActor>();
+		UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(Actor);
+		Actor->SetRootComponent(Mesh);
+		Mesh->RegisterComponent();
+
+		UThermalComponent* Component = NewObject<UThermalComponent>(Actor);
+		Component->RegisterComponent();
+		Component->SetCurrentTemperature(CurrentTemperature);
+
+		Actor->DispatchBeginPlay();
+		return Component;
+	}
+
+	// What every thermal actor did on its own tick before the subsystem batched the update: normalize its three
+	// temperatures to the range of the controller and set them on its material instance, whether they changed or not.
+	// Run natively, so it is a lower bound for the same work done in a blueprint event graph.
+	void UpdatePerActor(const TArray<UThermalComponent*>& Components, const AThermalController& Controller)
+	{
+		static const FName CurrentTemperatureName(TEXT("CurrentTemperature"));
+		static const FName MaxTemperatureName(TEXT("MaxTemperature"));
+		static const FName BaseTemperatureName(TEXT("BaseTemperature"));
+
+		for (const UThermalComponent* Component : Components) {
+			UMaterialInstanceDynamic* DynamicMaterialInstance = Component->GetDynamicMaterialInstance();
+			if (!DynamicMaterialInstance) continue;
+
+			const FThermalState& State = Component->GetThermalState();
+			const float RangeMin = Controller.GetThermalCameraRangeMin();
+			const float RangeMax = Controller.GetThermalCameraRangeMax();
+			DynamicMaterialInstance->SetScalarParameterValue(CurrentTemperatureName, UKismetMathLibrary::NormalizeToRange(Component->GetCurrentTemperature(), RangeMin, RangeMax));
+			DynamicMaterialInstance->SetScalarParameterValue(MaxTemperatureName, UKismetMathLibrary::NormalizeToRange(State.MaxTemperature, RangeMin, RangeMax));
+			DynamicMaterialInstance->SetScalarParameterValue(BaseTemperatureName, UKismetMathLibrary::NormalizeToRange(State.BaseTemperature, RangeMin, RangeMax));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThermalUpdatePerfTest, "Logi.Thermal.Perf.Update",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FThermalUpdatePerfTest::RunTest(const FString& Parameters)
+{
+	//Every actor gets a dynamic material instance of the engine default material, the parameters it does not have are ignored
+	ULogiSettings* Settings = GetMutableDefault<ULogiSettings>();
+	const EThermalMaterialMode OldMaterialMode = Settings->ThermalMaterialMode;
+	const TSoftObjectPtr<UMaterialInterface> OldThermalMaterial = Settings->ThermalMaterial;
+	Settings->ThermalMaterialMode = EThermalMaterialMode::DynamicMaterialInstance;
+	Settings->ThermalMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+	ON_SCOPE_EXIT {
+		Settings->ThermalMaterialMode = OldMaterialMode;
+		Settings->ThermalMaterial = OldThermalMaterial;
+	};
+
+	//Without views every actor would be frozen, and the budget would spread a full update over several frames
+	const FThermalScopedCVar Significance(TEXT("Logi.Thermal.Significance.Enabled"), TEXT("0"));
+	const FThermalScopedCVar Budget(TEXT("Logi.Thermal.UpdateBudgetUs"), TEXT("0"));
+
+	for (const int32 NumActors : {1000, 10000}) {
+		const FThermalTestWorld TestWorld;
+		UThermalWorldSubsystem* Subsystem = TestWorld.GetSubsystem();
+		if (!TestNotNull(TEXT("Thermal world subsystem"), Subsystem)) return false;
+
+		AThermalController* Controller = TestWorld.AddController();
+		TArray<UThermalComponent*> Components;
+		Components.Reserve(NumActors);
+		for (int32 Index = 0; Index < NumActors; ++Index) {
+			Components.Add(SpawnThermalActor(TestWorld, static_cast<float>(Index % 100)));
+		}
+		TestEqual(TEXT("Registered thermal components"), Subsystem->GetNumThermalComponents(), NumActors);
+
+		//The first tick sends every new actor, measure the frames after it
+		Subsystem->Tick(FrameSeconds);
+
+		double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+			UpdatePerActor(Components, *Controller);
+		}
+		const double PerActorSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumFrames;
+
+		StartSeconds = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+			Subsystem->Tick(FrameSeconds);
+		}
+		const double UnchangedSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumFrames;
+
+		//A new range changes the normalized temperatures of every actor
+		StartSeconds = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+			Controller->SetThermalCameraRangeMax(100.0f + (Frame & 1));
+			Subsystem->Tick(FrameSeconds);
+		}
+		const double ChangedSeconds = (FPlatformTime::Seconds() - StartSeconds) / NumFrames;
+
+		AddInfo(FString::Printf(TEXT("%d actors: per actor update %.3f ms, subsystem %.3f ms unchanged, %.3f ms all changed per frame"),
+			NumActors, PerActorSeconds * 1000.0, UnchangedSeconds * 1000.0, ChangedSeconds * 1000.0));
+
+		TestTrue(TEXT("Unchanged frames cost less than updating every actor"), UnchangedSeconds < PerActorSeconds);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "ThermalAmbientVolume.h"
+
+#include "ThermalStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Thermal ambient bricks"), STAT_LogiThermalAmbientBricks, STATGROUP_Logi);
+
+namespace
+{
+	// Offsets closer to 0 than this count as the background temperature, bricks of only those are freed
+	constexpr float DefaultOffsetTolerance = 0.001f;
+
+	FIntVector GetBrick(const FIntVector& Voxel)
+	{
+		//Arithmetic shift rounds down for negative voxels as well
+		return FIntVector(Voxel.X >> FThermalAmbientVolume::BrickShift, Voxel.Y >> FThermalAmbientVolume::BrickShift, Voxel.Z >> FThermalAmbientVolume::BrickShift);
+	}
+}
+
+void FThermalAmbientVolume::SetVoxelSize(const float InVoxelSize)
+{
+	const float NewVoxelSize = FMath::Max(InVoxelSize, 1.0f);
+	if (NewVoxelSize == VoxelSize) return;
+
+	Reset();
+	VoxelSize = NewVoxelSize;
+	InvVoxelSize = 1.0f / NewVoxelSize;
+}
+
+void FThermalAmbientVolume::Reset()
+{
+	BrickIndices.Reset();
+	BrickData.Reset();
+	FreeBricks.Reset();
+
+	SET_DWORD_STAT(STAT_LogiThermalAmbientBricks, 0);
+}
+
+void FThermalAmbientVolume::Stamp(const FVector& Center, const float Radius, const float Offset)
+{
+	if (Radius <= 0.0f || Offset == 0.0f) return;
+
+	//Voxels inside the bounds of the stamp
+	const FIntVector MinVoxel(
+		FMath::CeilToInt32((Center.X - Radius) * InvVoxelSize),
+		FMath::CeilToInt32((Center.Y - Radius) * InvVoxelSize),
+		FMath::CeilToInt32((Center.Z - Radius) * InvVoxelSize));
+	const FIntVector MaxVoxel(
+		FMath::FloorToInt32((Center.X + Radius) * InvVoxelSize),
+		FMath::FloorToInt32((Center.Y + Radius) * InvVoxelSize),
+		FMath::FloorToInt32((Center.Z + Radius) * InvVoxelSize));
+
+	//A voxel on the low face of a brick is also the shared layer of the brick below it
+	const FIntVector MinBrick = GetBrick(MinVoxel - FIntVector(1));
+	const FIntVector MaxBrick = GetBrick(MaxVoxel);
+
+	for (int32 BrickZ = MinBrick.Z; BrickZ <= MaxBrick.Z; ++BrickZ) {
+		for (int32 BrickY = MinBrick.Y; BrickY <= MaxBrick.Y; ++BrickY) {
+			for (int32 BrickX = MinBrick.X; BrickX <= MaxBrick.X; ++BrickX) {
+				const FIntVector Brick(BrickX, BrickY, BrickZ);
+				const FIntVector BrickOrigin = Brick * BrickSize;
+
+				//Allocated on the first sample the stamp reaches
+				float* Data = nullptr;
+
+				for (int32 Z = FMath::Max(MinVoxel.Z - BrickOrigin.Z, 0); Z <= FMath::Min(MaxVoxel.Z - BrickOrigin.Z, BrickSize); ++Z) {
+					for (int32 Y = FMath::Max(MinVoxel.Y - BrickOrigin.Y, 0); Y <= FMath::Min(MaxVoxel.Y - BrickOrigin.Y, BrickSize); ++Y) {
+						for (int32 X = FMath::Max(MinVoxel.X - BrickOrigin.X, 0); X <= FMath::Min(MaxVoxel.X - BrickOrigin.X, BrickSize); ++X) {
+							const FVector VoxelLocation = FVector(BrickOrigin + FIntVector(X, Y, Z)) * VoxelSize;
+							const float Falloff = 1.0f - FVector::Dist(VoxelLocation, Center) / Radius;
+							if (Falloff <= 0.0f) continue;
+
+							if (!Data) {
+								Data = FindOrAddBrick(Brick);
+							}
+
+							Data[X + (Y + Z * BrickSamples) * BrickSamples] += Offset * Falloff;
+						}
+					}
+				}
+
+				if (!Data) continue;
+
+				//Stamps of opposite sign cancel out, give the memory back once the brick is at the background temperature again
+				bool bDefault = true;
+				for (int32 Sample = 0; bDefault && Sample < BrickSampleCount; ++Sample) {
+					bDefault = FMath::Abs(Data[Sample]) <= DefaultOffsetTolerance;
+				}
+
+				if (bDefault) {
+					FreeBrick(Brick, BrickIndices.FindChecked(Brick));
+				}
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_LogiThermalAmbientBricks, BrickIndices.Num());
+}
+
+float FThermalAmbientVolume::Sample(const FVector3f& Location) const
+{
+	if (BrickIndices.Num() == 0) return 0.0f;
+
+	const FVector3f Voxel = Location * InvVoxelSize;
+	const FIntVector Cell(FMath::FloorToInt32(Voxel.X), FMath::FloorToInt32(Voxel.Y), FMath::FloorToInt32(Voxel.Z));
+
+	const int32* BrickIndex = BrickIndices.Find(GetBrick(Cell));
+	if (!BrickIndex) return 0.0f;
+
+	//The eight corners of the cell are in this brick, the far ones in its shared layer
+	const FIntVector Local(Cell.X & (BrickSize - 1), Cell.Y & (BrickSize - 1), Cell.Z & (BrickSize - 1));
+	const float* Data = BrickData.GetData() + *BrickIndex * BrickSampleCount + Local.X + (Local.Y + Local.Z * BrickSamples) * BrickSamples;
+
+	constexpr int32 StepY = BrickSamples;
+	constexpr int32 StepZ = BrickSamples * BrickSamples;
+
+	const float FracX = Voxel.X - Cell.X;
+	const float FracY = Voxel.Y - Cell.Y;
+	const float FracZ = Voxel.Z - Cell.Z;
+
+	const float Near = FMath::Lerp(FMath::Lerp(Data[0], Data[1], FracX), FMath::Lerp(Data[StepY], Data[StepY + 1], FracX), FracY);
+	const float Far = FMath::Lerp(FMath::Lerp(Data[StepZ], Data[StepZ + 1], FracX), FMath::Lerp(Data[StepZ + StepY], Data[StepZ + StepY + 1], FracX), FracY);
+
+	return FMath::Lerp(Near, Far, FracZ);
+}
+
+float* FThermalAmbientVolume::FindOrAddBrick(const FIntVector& Brick)
+{
+	int32 BrickIndex;
+
+	if (const int32* ExistingIndex = BrickIndices.Find(Brick)) {
+		BrickIndex = *ExistingIndex;
+	}
+	else {
+		if (FreeBricks.Num() > 0) {
+			BrickIndex = FreeBricks.Pop(false);
+		}
+		else {
+			BrickIndex = BrickData.Num() / BrickSampleCount;
+			BrickData.AddUninitialized(BrickSampleCount);
+		}
+
+		FMemory::Memzero(BrickData.GetData() + BrickIndex * BrickSampleCount, BrickSampleCount * sizeof(float));
+		BrickIndices.Add(Brick, BrickIndex);
+	}
+
+	return BrickData.GetData() + BrickIndex * BrickSampleCount;
+}
+
+void FThermalAmbientVolume::FreeBrick(const FIntVector& Brick, const int32 BrickIndex)
+{
+	BrickIndices.Remove(Brick);
+	FreeBricks.Add(BrickIndex);
+}
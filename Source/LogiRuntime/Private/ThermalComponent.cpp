@@ -0,0 +1,540 @@
+#include "ThermalComponent.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/MeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "LogiSettings.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ThermalControllerActor.h"
+#include "ThermalStats.h"
+#include "ThermalTemperatureStore.h"
+#include "ThermalWorldSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Thermal material swaps"), STAT_LogiThermalMaterialSwaps, STATGROUP_Logi);
+
+UThermalComponent::UThermalComponent()
+{
+	//The thermal world subsystem updates all thermal components in one pass, the components never tick
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UThermalComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	//Templates keep an empty key, loaded components overwrite the new one with their saved key
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) && !ThermalGuid.IsValid()) {
+		ThermalGuid = FGuid::NewGuid();
+	}
+}
+
+void UThermalComponent::PostDuplicate(const bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+
+	//Duplicated actors are new actors, play in editor keeps the keys of the level
+	if (!bDuplicateForPIE && !HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) {
+		ThermalGuid = FGuid::NewGuid();
+	}
+}
+
+#if WITH_EDITOR
+void UThermalComponent::PostEditImport()
+{
+	Super::PostEditImport();
+
+	//Pasted actors are new actors as well
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) {
+		ThermalGuid = FGuid::NewGuid();
+	}
+}
+#endif
+
+void UThermalComponent::SetThermalGuid(const FGuid& InThermalGuid)
+{
+	ThermalGuid = InThermalGuid;
+}
+
+void UThermalComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CacheThermalMeshes();
+	UpdateRenderCustomDepth();
+
+	const ULogiSettings* Settings = GetDefault<ULogiSettings>();
+	bUsesCustomPrimitiveData = Settings->UseCustomPrimitiveData();
+
+	if (UMaterialInterface* ProjectThermalMaterial = Settings->GetThermalMaterial().LoadSynchronous()) {
+		//Custom primitive data meshes all share the project material, otherwise every actor gets its own dynamic material instance
+		if (bUsesCustomPrimitiveData) {
+			ThermalMaterial = ProjectThermalMaterial;
+		}
+		else {
+			DynamicMaterialInstance = UMaterialInstanceDynamic::Create(ProjectThermalMaterial, this);
+			ThermalMaterial = DynamicMaterialInstance;
+		}
+	}
+	else {
+		UE_LOG(LogTemp, Error, TEXT("Failed to load the thermal material for '%s'"), *GetNameSafe(GetOwner()));
+	}
+
+	if (ThermalInstances.Num() > 0) {
+		InstancedThermalMaterial = Settings->InstancedThermalMaterial.LoadSynchronous();
+	}
+
+	ApplyThermalMaterialClasses();
+
+	//The subsystem hands out the thermal controller of the level, or assigns it later if the controller has not spawned yet
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->RegisterThermalComponent(this);
+	}
+}
+
+void UThermalComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ThermalState.CurrentTemperature = GetCurrentTemperature();
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->UnregisterThermalComponent(this);
+	}
+
+	//Only unbind, the materials are left as they are while the actor is torn down
+	if (ThermalController) {
+		ThermalController->OnThermalModeChanged.RemoveDynamic(this, &UThermalComponent::HandleThermalModeChanged);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UThermalComponent::CacheThermalMeshes()
+{
+	ThermalMeshes.Reset();
+	ThermalInstances.Reset();
+	ThermalSections.Reset();
+
+	const ULogiSettings* Settings = GetDefault<ULogiSettings>();
+	float ConductivitySum = 0.0f;
+
+	//Store the original materials of every mesh, these are restored when the thermal camera is turned off
+	TInlineComponentArray<UMeshComponent*> MeshComponents(GetOwner());
+	for (UMeshComponent* MeshComponent : MeshComponents) {
+		if (!MeshComponent->IsA<UStaticMeshComponent>() && !MeshComponent->IsA<USkeletalMeshComponent>()) continue;
+
+		FThermalMeshMaterials& Meshes = ThermalMeshes.AddDefaulted_GetRef();
+		Meshes.Mesh = MeshComponent;
+		Meshes.OriginalMaterials = MeshComponent->GetMaterials();
+
+		//The first slot whose physical material has a class decides the class of the mesh
+		Meshes.MaterialClass = Settings->DefaultThermalMaterialClass;
+		for (const UMaterialInterface* Material : Meshes.OriginalMaterials) {
+			if (const FThermalMaterialClass* MaterialClass = Settings->FindThermalMaterialClass(Material ? Material->GetPhysicalMaterial() : nullptr)) {
+				Meshes.MaterialClass = *MaterialClass;
+				break;
+			}
+		}
+		ConductivitySum += Meshes.MaterialClass.Conductivity;
+
+		//Instanced static meshes (and HISMs) keep one temperature per instance in their per instance custom data
+		if (UInstancedStaticMeshComponent* InstancedMesh = Cast<UInstancedStaticMeshComponent>(MeshComponent)) {
+			Meshes.bInstanced = true;
+
+			if (InstancedMesh->NumCustomDataFloats < ThermalPrimitiveData::NumFloats) {
+				InstancedMesh->SetNumCustomDataFloats(ThermalPrimitiveData::NumFloats);
+			}
+
+			FThermalInstanceTemperatures& Instances = ThermalInstances.AddDefaulted_GetRef();
+			Instances.Mesh = InstancedMesh;
+			SyncInstanceCount(Instances);
+		}
+		//Skeletal meshes keep one temperature per material slot in their custom primitive data
+		else if (USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(MeshComponent)) {
+			Meshes.bSkeletal = true;
+
+			FThermalSectionTemperatures& Sections = ThermalSections.AddDefaulted_GetRef();
+			Sections.Mesh = SkeletalMesh;
+		}
+	}
+
+	Conductivity = ThermalMeshes.Num() > 0 ? ConductivitySum / ThermalMeshes.Num() : Settings->DefaultThermalMaterialClass.Conductivity;
+}
+
+void UThermalComponent::ApplyThermalMaterialClasses() const
+{
+	static const FName EmissivityParameterName(TEXT("Emissivity"));
+	static const FName ReflectivityParameterName(TEXT("Reflectivity"));
+
+	//The shared materials read the class from custom primitive data, it never changes after this. Meshes that get the
+	//dynamic material instance read it from its parameters instead, so they are left without custom primitive data.
+	for (const FThermalMeshMaterials& Meshes : ThermalMeshes) {
+		if (!bUsesCustomPrimitiveData && !Meshes.bInstanced && !Meshes.bSkeletal) continue;
+
+		if (UMeshComponent* MeshComponent = Meshes.Mesh.Get()) {
+			MeshComponent->SetCustomPrimitiveDataFloat(ThermalPrimitiveData::Emissivity, Meshes.MaterialClass.Emissivity);
+			MeshComponent->SetCustomPrimitiveDataFloat(ThermalPrimitiveData::Reflectivity, Meshes.MaterialClass.Reflectivity);
+		}
+	}
+
+	if (!DynamicMaterialInstance) return;
+
+	//One dynamic material instance covers every mesh of the actor that uses it, it takes the class of the first of them
+	const FThermalMeshMaterials* FirstMeshes = ThermalMeshes.FindByPredicate([](const FThermalMeshMaterials& Meshes)
+	{
+		return !Meshes.bInstanced && !Meshes.bSkeletal;
+	});
+	if (!FirstMeshes) return;
+
+	DynamicMaterialInstance->SetScalarParameterValue(EmissivityParameterName, FirstMeshes->MaterialClass.Emissivity);
+	DynamicMaterialInstance->SetScalarParameterValue(ReflectivityParameterName, FirstMeshes->MaterialClass.Reflectivity);
+
+	//Meshes of other classes show the class of the first one, the custom primitive data mode gives every mesh its own class
+	for (const FThermalMeshMaterials& Meshes : ThermalMeshes) {
+		if (Meshes.bInstanced || Meshes.bSkeletal) continue;
+
+		if (Meshes.MaterialClass.Emissivity != FirstMeshes->MaterialClass.Emissivity || Meshes.MaterialClass.Reflectivity != FirstMeshes->MaterialClass.Reflectivity) {
+			UE_LOG(LogTemp, Warning, TEXT("Thermal actor '%s' has meshes of different thermal material classes, they all show the class of '%s'. Use the custom primitive data thermal material mode to keep them apart."),
+				*GetNameSafe(GetOwner()), *GetNameSafe(FirstMeshes->Mesh.Get()));
+			break;
+		}
+	}
+}
+
+void UThermalComponent::UpdateRenderCustomDepth() const
+{
+	for (const FThermalMeshMaterials& Meshes : ThermalMeshes) {
+		if (UMeshComponent* MeshComponent = Meshes.Mesh.Get()) {
+			MeshComponent->SetRenderCustomDepth(ThermalState.bHot);
+		}
+	}
+}
+
+void UThermalComponent::SetThermalController(AThermalController* NewController)
+{
+	if (ThermalController && ThermalController != NewController) {
+		ThermalController->OnThermalModeChanged.RemoveDynamic(this, &UThermalComponent::HandleThermalModeChanged);
+	}
+
+	ThermalController = NewController;
+
+	//Materials are only swapped when the thermal camera is turned on or off
+	if (ThermalController) {
+		ThermalController->OnThermalModeChanged.AddUniqueDynamic(this, &UThermalComponent::HandleThermalModeChanged);
+		ApplyThermalMode(ThermalController->IsThermalCameraActive());
+		RefreshInstanceTemperatures();
+	}
+	else {
+		ApplyThermalMode(false);
+	}
+}
+
+void UThermalComponent::HandleThermalModeChanged(const bool bThermalCameraActive)
+{
+	ApplyThermalMode(bThermalCameraActive);
+}
+
+void UThermalComponent::ApplyThermalMode(const bool bThermalCameraActive)
+{
+	//Select the thermal material when the thermal camera is on, the original material otherwise
+	const uint8 MaterialIndex = bThermalCameraActive ? 1 : 0;
+	if (ThermalState.MaterialIndex == MaterialIndex) return;
+
+	ThermalState.MaterialIndex = MaterialIndex;
+
+	UThermalWorldSubsystem* Subsystem = ThermalSections.Num() > 0 ? GetWorld()->GetSubsystem<UThermalWorldSubsystem>() : nullptr;
+
+	//Set the material of every material slot of every mesh
+	for (const FThermalMeshMaterials& Meshes : ThermalMeshes) {
+		UMeshComponent* MeshComponent = Meshes.Mesh.Get();
+		if (!MeshComponent) continue;
+
+		for (int32 SlotIndex = 0; SlotIndex < Meshes.OriginalMaterials.Num(); ++SlotIndex) {
+			UMaterialInterface* Material = MaterialIndex == 1 ? (Meshes.bInstanced ? InstancedThermalMaterial.Get() : ThermalMaterial.Get()) : Meshes.OriginalMaterials[SlotIndex].Get();
+
+			//Every skeletal mesh shares one material per slot, the slot picks its temperature from the custom primitive data
+			if (MaterialIndex == 1 && Meshes.bSkeletal && Subsystem) {
+				if (UMaterialInterface* SectionMaterial = Subsystem->GetSkeletalSectionMaterial(SlotIndex)) {
+					Material = SectionMaterial;
+				}
+			}
+
+			MeshComponent->SetMaterial(SlotIndex, Material);
+		}
+	}
+
+	INC_DWORD_STAT(STAT_LogiThermalMaterialSwaps);
+}
+
+void UThermalComponent::SetCurrentTemperature(const float Temperature)
+{
+	ThermalState.CurrentTemperature = Temperature;
+	UpdateTemperatures();
+}
+
+void UThermalComponent::SetBaseTemperature(const float Temperature)
+{
+	//Keep the heating or cooling done so far
+	ThermalState.CurrentTemperature = GetCurrentTemperature();
+	ThermalState.BaseTemperature = Temperature;
+	UpdateTemperatures();
+}
+
+void UThermalComponent::SetMaxTemperature(const float Temperature)
+{
+	ThermalState.CurrentTemperature = GetCurrentTemperature();
+	ThermalState.MaxTemperature = Temperature;
+	UpdateTemperatures();
+}
+
+void UThermalComponent::UpdateTemperatures()
+{
+	if (ThermalIndex == INDEX_NONE) return;
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->UpdateTemperatures(*this);
+	}
+}
+
+void UThermalComponent::SetThermalActive(const bool bInActive)
+{
+	if (ThermalState.bActive == bInActive) return;
+
+	ThermalState.bActive = bInActive;
+	UpdateTransient();
+}
+
+void UThermalComponent::SetExchangeHeat(const bool bInExchangeHeat)
+{
+	if (ThermalState.bExchangeHeat == bInExchangeHeat) return;
+
+	ThermalState.bExchangeHeat = bInExchangeHeat;
+	UpdateTransient();
+}
+
+void UThermalComponent::SetAbsorptivity(const float InAbsorptivity)
+{
+	ThermalState.Absorptivity = FMath::Clamp(InAbsorptivity, 0.0f, 1.0f);
+
+	if (ThermalIndex == INDEX_NONE) return;
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->UpdateSolar(*this);
+	}
+}
+
+void UThermalComponent::SetTimeConstants(const float HeatingTimeConstant, const float CoolingTimeConstant, const bool bCoolToAmbient)
+{
+	ThermalState.HeatingTimeConstant = FMath::Max(HeatingTimeConstant, 0.0f);
+	ThermalState.CoolingTimeConstant = FMath::Max(CoolingTimeConstant, 0.0f);
+	ThermalState.bCoolToAmbient = bCoolToAmbient;
+	UpdateTransient();
+}
+
+void UThermalComponent::UpdateTransient() const
+{
+	if (ThermalIndex == INDEX_NONE) return;
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->UpdateTransient(*this);
+	}
+}
+
+void UThermalComponent::PlayThermalProfile(UThermalProfile* NewProfile)
+{
+	ThermalState.Profile = NewProfile;
+
+	if (ThermalIndex == INDEX_NONE) return;
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->PlayThermalProfile(*this);
+	}
+}
+
+void UThermalComponent::StopThermalProfile()
+{
+	PlayThermalProfile(nullptr);
+}
+
+float UThermalComponent::GetCurrentTemperature() const
+{
+	if (ThermalIndex != INDEX_NONE) {
+		if (const UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+			return Subsystem->GetCurrentTemperature(*this);
+		}
+	}
+
+	return ThermalState.CurrentTemperature;
+}
+
+void UThermalComponent::SetHot(const bool bInHot)
+{
+	if (ThermalState.bHot == bInHot) return;
+
+	ThermalState.bHot = bInHot;
+	UpdateRenderCustomDepth();
+}
+
+FThermalInstanceTemperatures* UThermalComponent::FindThermalInstances(const UInstancedStaticMeshComponent* Mesh)
+{
+	return ThermalInstances.FindByPredicate([Mesh](const FThermalInstanceTemperatures& Instances) { return Instances.Mesh.Get() == Mesh; });
+}
+
+void UThermalComponent::SyncInstanceCount(FThermalInstanceTemperatures& Instances) const
+{
+	const UInstancedStaticMeshComponent* Mesh = Instances.Mesh.Get();
+	if (!Mesh) return;
+
+	const int32 NumFloats = Mesh->GetInstanceCount() * ThermalPrimitiveData::NumFloats;
+	const int32 OldNumFloats = Instances.Temperatures.Num();
+
+	if (NumFloats == OldNumFloats) return;
+
+	Instances.Temperatures.SetNumUninitialized(NumFloats);
+	Instances.NormalizedTemperatures.SetNumZeroed(NumFloats);
+
+	for (int32 Index = OldNumFloats; Index < NumFloats; Index += ThermalPrimitiveData::NumFloats) {
+		Instances.Temperatures[Index + ThermalPrimitiveData::BaseTemperature] = ThermalState.BaseTemperature;
+		Instances.Temperatures[Index + ThermalPrimitiveData::CurrentTemperature] = ThermalState.CurrentTemperature;
+		Instances.Temperatures[Index + ThermalPrimitiveData::MaxTemperature] = ThermalState.MaxTemperature;
+	}
+}
+
+void UThermalComponent::SetInstanceTemperatureRange(UInstancedStaticMeshComponent* Mesh, const int32 StartInstance, const int32 NumInstances, const float BaseTemperature, const float CurrentTemperature, const float MaxTemperature)
+{
+	FThermalInstanceTemperatures* Instances = FindThermalInstances(Mesh);
+	if (!Instances || NumInstances <= 0) return;
+
+	SyncInstanceCount(*Instances);
+
+	const int32 NumMeshInstances = Instances->Temperatures.Num() / ThermalPrimitiveData::NumFloats;
+	const int32 FirstInstance = FMath::Clamp(StartInstance, 0, NumMeshInstances);
+	const int32 EndInstance = FMath::Clamp(StartInstance + NumInstances, FirstInstance, NumMeshInstances);
+
+	for (int32 Instance = FirstInstance; Instance < EndInstance; ++Instance) {
+		float* Temperatures = Instances->Temperatures.GetData() + Instance * ThermalPrimitiveData::NumFloats;
+		Temperatures[ThermalPrimitiveData::BaseTemperature] = BaseTemperature;
+		Temperatures[ThermalPrimitiveData::CurrentTemperature] = CurrentTemperature;
+		Temperatures[ThermalPrimitiveData::MaxTemperature] = MaxTemperature;
+	}
+
+	WriteInstanceTemperatures(*Instances, FirstInstance, EndInstance - FirstInstance);
+}
+
+void UThermalComponent::SetInstanceCurrentTemperatures(UInstancedStaticMeshComponent* Mesh, const int32 StartInstance, const TArray<float>& CurrentTemperatures)
+{
+	FThermalInstanceTemperatures* Instances = FindThermalInstances(Mesh);
+	if (!Instances) return;
+
+	SyncInstanceCount(*Instances);
+
+	const int32 NumMeshInstances = Instances->Temperatures.Num() / ThermalPrimitiveData::NumFloats;
+	const int32 FirstInstance = FMath::Clamp(StartInstance, 0, NumMeshInstances);
+	const int32 EndInstance = FMath::Clamp(StartInstance + CurrentTemperatures.Num(), FirstInstance, NumMeshInstances);
+
+	for (int32 Instance = FirstInstance; Instance < EndInstance; ++Instance) {
+		Instances->Temperatures[Instance * ThermalPrimitiveData::NumFloats + ThermalPrimitiveData::CurrentTemperature] = CurrentTemperatures[Instance - StartInstance];
+	}
+
+	WriteInstanceTemperatures(*Instances, FirstInstance, EndInstance - FirstInstance);
+}
+
+void UThermalComponent::SetInstanceTemperatures(UInstancedStaticMeshComponent* Mesh, const int32 StartInstance, const TConstArrayView<float> InterleavedTemperatures)
+{
+	FThermalInstanceTemperatures* Instances = FindThermalInstances(Mesh);
+	if (!Instances || StartInstance < 0) return;
+
+	SyncInstanceCount(*Instances);
+
+	const int32 NumMeshInstances = Instances->Temperatures.Num() / ThermalPrimitiveData::NumFloats;
+	const int32 FirstInstance = FMath::Min(StartInstance, NumMeshInstances);
+	const int32 NumInstances = FMath::Min(InterleavedTemperatures.Num() / ThermalPrimitiveData::NumFloats, NumMeshInstances - FirstInstance);
+
+	FMemory::Memcpy(Instances->Temperatures.GetData() + FirstInstance * ThermalPrimitiveData::NumFloats, InterleavedTemperatures.GetData(), NumInstances * ThermalPrimitiveData::NumFloats * sizeof(float));
+
+	WriteInstanceTemperatures(*Instances, FirstInstance, NumInstances);
+}
+
+void UThermalComponent::RefreshInstanceTemperatures()
+{
+	for (FThermalInstanceTemperatures& Instances : ThermalInstances) {
+		SyncInstanceCount(Instances);
+		WriteInstanceTemperatures(Instances, 0, Instances.Temperatures.Num() / ThermalPrimitiveData::NumFloats);
+	}
+}
+
+void UThermalComponent::WriteInstanceTemperatures(FThermalInstanceTemperatures& Instances, const int32 StartInstance, const int32 NumInstances) const
+{
+	UInstancedStaticMeshComponent* Mesh = Instances.Mesh.Get();
+	if (!Mesh || !ThermalController || NumInstances <= 0) return;
+
+	//Base, current and max share the camera range, so the interleaved slice is normalized in one pass
+	const int32 FirstFloat = StartInstance * ThermalPrimitiveData::NumFloats;
+	FThermalTemperatureStore::NormalizeToRange(Instances.Temperatures.GetData() + FirstFloat, Instances.NormalizedTemperatures.GetData() + FirstFloat,
+		NumInstances * ThermalPrimitiveData::NumFloats, ThermalController->GetThermalCameraRangeMin(), ThermalController->GetThermalCameraRangeMax());
+
+	//Each instance goes through the instance update buffer, the last one of the range sends the buffered edits to the proxy as one instance data update
+	const int32 EndInstance = StartInstance + NumInstances;
+
+	for (int32 Instance = StartInstance; Instance < EndInstance; ++Instance) {
+		Mesh->SetCustomData(Instance, MakeArrayView(Instances.NormalizedTemperatures.GetData() + Instance * ThermalPrimitiveData::NumFloats, ThermalPrimitiveData::NumFloats), Instance == EndInstance - 1);
+	}
+}
+
+FThermalSectionTemperatures* UThermalComponent::FindThermalSections(const USkeletalMeshComponent* Mesh)
+{
+	return ThermalSections.FindByPredicate([Mesh](const FThermalSectionTemperatures& Sections) { return Sections.Mesh.Get() == Mesh; });
+}
+
+void UThermalComponent::SetSectionTemperature(USkeletalMeshComponent* Mesh, const int32 MaterialSlot, const float Temperature)
+{
+	FThermalSectionTemperatures* Sections = FindThermalSections(Mesh);
+	if (!Sections || MaterialSlot < 0) return;
+
+	const int32 Section = FMath::Min(MaterialSlot, ThermalPrimitiveData::MaxSections - 1);
+	Sections->Temperatures[Section] = Temperature;
+	Sections->OverrideMask |= 1 << Section;
+
+	PrioritizeUpdate();
+}
+
+void UThermalComponent::SetBoneTemperature(USkeletalMeshComponent* Mesh, const FName BoneName, const float Temperature)
+{
+	FThermalSectionTemperatures* Sections = FindThermalSections(Mesh);
+	const FSkeletalMeshRenderData* RenderData = Mesh ? Mesh->GetSkeletalMeshRenderData() : nullptr;
+	if (!Sections || !RenderData || RenderData->LODRenderData.Num() == 0) return;
+
+	const int32 BoneIndex = Mesh->GetBoneIndex(BoneName);
+	if (BoneIndex == INDEX_NONE) return;
+
+	//A bone can be skinned into several sections, all of their slots get the temperature
+	for (const FSkelMeshRenderSection& RenderSection : RenderData->LODRenderData[0].RenderSections) {
+		if (!RenderSection.BoneMap.Contains(static_cast<FBoneIndexType>(BoneIndex))) continue;
+
+		const int32 Section = FMath::Min<int32>(RenderSection.MaterialIndex, ThermalPrimitiveData::MaxSections - 1);
+		Sections->Temperatures[Section] = Temperature;
+		Sections->OverrideMask |= 1 << Section;
+	}
+
+	PrioritizeUpdate();
+}
+
+void UThermalComponent::ClearSectionTemperatures(USkeletalMeshComponent* Mesh)
+{
+	FThermalSectionTemperatures* Sections = FindThermalSections(Mesh);
+	if (!Sections || Sections->OverrideMask == 0) return;
+
+	Sections->OverrideMask = 0;
+	PrioritizeUpdate();
+}
+
+void UThermalComponent::PrioritizeUpdate() const
+{
+	if (ThermalIndex == INDEX_NONE) return;
+
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->PrioritizeThermalComponent(*this);
+	}
+}
@@ -0,0 +1,386 @@
+#include "ThermalControllerActor.h"
+
+#include "Engine/World.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "ThermalPalettes.h"
+#include "ThermalSceneViewExtension.h"
+#include "ThermalStats.h"
+#include "ThermalWorldSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Thermal settings update"), STAT_LogiThermalSettingsUpdate, STATGROUP_Logi);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Thermal settings MPC updates"), STAT_LogiThermalSettingsUpdates, STATGROUP_Logi);
+
+namespace
+{
+	// Parameters of MPC_Logi_ThermalSettings
+	const FName ThermalCameraToggleParameterName(TEXT("ThermalCameraToggle"));
+	const FName BackgroundTemperatureParameterName(TEXT("BackgroundTemperature"));
+	const FName SkyTemperatureParameterName(TEXT("SkyTemperature"));
+	const FName BlurParameterName(TEXT("Blur"));
+	const FName NoiseAmountParameterName(TEXT("NoiseAmount"));
+	const FName ColdParameterName(TEXT("Cold"));
+	const FName MidParameterName(TEXT("Mid"));
+	const FName HotParameterName(TEXT("Hot"));
+	const FName NoiseSizeParameterName(TEXT("NoiseSize"));
+	const FName SensorResolutionParameterName(TEXT("SensorResolution"));
+	const FName PaletteParameterName(TEXT("Palette"));
+	const FName NoiseModeParameterName(TEXT("NoiseMode"));
+
+	// Blur and noise amount are authored as 0-100 on the controller and read as 0-1 by the post process material
+	constexpr float PercentRangeMax = 100.0f;
+
+	//Every palette after Custom is a row of the lookup, in the same order
+	static_assert(static_cast<int32>(EThermalPalette::BlackHot) == ThermalPalettes::NumPalettes, "EThermalPalette has to match the rows of ThermalPalettes");
+}
+
+AThermalController::AThermalController()
+{
+	//The controller only ticks on frames where a setting has changed, the first tick writes every parameter
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	ThermalSettings = TSoftObjectPtr<UMaterialParameterCollection>(FSoftObjectPath(TEXT("/Game/Logi_ThermalCamera/Materials/MPC_Logi_ThermalSettings.MPC_Logi_ThermalSettings")));
+}
+
+void AThermalController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	//Every parameter is written once when play starts, the MPC instance of a new world holds the collection defaults
+	MarkThermalSettingsDirty(EThermalSettingsDirty::All);
+
+	//Register so thermal components get the controller without searching the level
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->RegisterThermalController(this);
+	}
+}
+
+void AThermalController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UThermalWorldSubsystem* Subsystem = GetWorld()->GetSubsystem<UThermalWorldSubsystem>()) {
+		Subsystem->UnregisterThermalController(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AThermalController::ShouldTickIfViewportsOnly() const
+{
+	//Lets the editor viewport preview the settings while they are edited
+	return true;
+}
+
+void AThermalController::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	FlushThermalSettings();
+}
+
+void AThermalController::MarkThermalSettingsDirty(const EThermalSettingsDirty Flags)
+{
+	if (Flags == EThermalSettingsDirty::None) return;
+
+	DirtyMask |= Flags;
+	SetActorTickEnabled(true);
+}
+
+void AThermalController::FlushThermalSettings()
+{
+	//Nothing changed since the last update, go back to sleep
+	if (DirtyMask == EThermalSettingsDirty::None) {
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSettingsUpdate);
+
+	UWorld* World = GetWorld();
+
+	//The thermal image extension gets every setting at once, PP_Logi_ThermalCamera then stays off and passes the scene through
+	UThermalWorldSubsystem* Subsystem = World ? World->GetSubsystem<UThermalWorldSubsystem>() : nullptr;
+	const bool bThermalImageExtension = Subsystem && Subsystem->UpdateThermalImage(MakeThermalImageSettings());
+
+	UMaterialParameterCollection* Collection = ThermalSettings.LoadSynchronous();
+	UMaterialParameterCollectionInstance* Instance = World && Collection ? World->GetParameterCollectionInstance(Collection) : nullptr;
+
+	if (!Instance) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to find the MPC_Logi_ThermalSettings instance for '%s'"), *GetName());
+		DirtyMask = EThermalSettingsDirty::None;
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	//The instance only queues a render state update, every parameter written here is sent to the render thread in one batch at the end of the frame
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::ThermalCameraToggle)) {
+		Instance->SetScalarParameterValue(ThermalCameraToggleParameterName, ThermalCameraActive && !bThermalImageExtension ? 1.0f : 0.0f);
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::BackgroundTemperature)) {
+		Instance->SetScalarParameterValue(BackgroundTemperatureParameterName, UKismetMathLibrary::NormalizeToRange(BackgroundTemperature, ThermalCameraRangeMin, ThermalCameraRangeMax));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::SkyTemperature)) {
+		Instance->SetScalarParameterValue(SkyTemperatureParameterName, UKismetMathLibrary::NormalizeToRange(SkyTemperature, ThermalCameraRangeMin, ThermalCameraRangeMax));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::Blur)) {
+		Instance->SetScalarParameterValue(BlurParameterName, UKismetMathLibrary::NormalizeToRange(Blur, 0.0f, PercentRangeMax));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::NoiseAmount)) {
+		Instance->SetScalarParameterValue(NoiseAmountParameterName, UKismetMathLibrary::NormalizeToRange(NoiseAmount, 0.0f, PercentRangeMax));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::Cold)) {
+		Instance->SetVectorParameterValue(ColdParameterName, Cold);
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::Mid)) {
+		Instance->SetVectorParameterValue(MidParameterName, Mid);
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::Hot)) {
+		Instance->SetVectorParameterValue(HotParameterName, Hot);
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::Palette)) {
+		Instance->SetScalarParameterValue(PaletteParameterName, static_cast<float>(Palette));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::NoiseMode)) {
+		Instance->SetScalarParameterValue(NoiseModeParameterName, static_cast<float>(NoiseMode));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::NoiseSize)) {
+		Instance->SetVectorParameterValue(NoiseSizeParameterName, FLinearColor(NoiseSize, NoiseSize, NoiseSize, 0.0f));
+	}
+
+	if (EnumHasAnyFlags(DirtyMask, EThermalSettingsDirty::SensorResolution)) {
+		Instance->SetVectorParameterValue(SensorResolutionParameterName, FLinearColor(SensorResolution.X, SensorResolution.Y, 0.0f, 0.0f));
+	}
+
+	INC_DWORD_STAT(STAT_LogiThermalSettingsUpdates);
+
+	DirtyMask = EThermalSettingsDirty::None;
+	SetActorTickEnabled(false);
+}
+
+FThermalImageSettings AThermalController::MakeThermalImageSettings() const
+{
+	FThermalImageSettings Settings;
+	Settings.bEnabled = ThermalCameraActive;
+	Settings.BackgroundTemperature = UKismetMathLibrary::NormalizeToRange(BackgroundTemperature, ThermalCameraRangeMin, ThermalCameraRangeMax);
+	Settings.SkyTemperature = UKismetMathLibrary::NormalizeToRange(SkyTemperature, ThermalCameraRangeMin, ThermalCameraRangeMax);
+	Settings.Blur = UKismetMathLibrary::NormalizeToRange(Blur, 0.0f, PercentRangeMax);
+	Settings.NoiseAmount = UKismetMathLibrary::NormalizeToRange(NoiseAmount, 0.0f, PercentRangeMax);
+	Settings.NoiseSize = NoiseSize;
+	Settings.bBlueNoise = NoiseMode == EThermalNoiseMode::BlueNoise;
+	Settings.SensorResolution = SensorResolution;
+	Settings.bBilinearUpscale = SensorUpscale == EThermalSensorUpscale::Bilinear;
+	Settings.Palette = Palette == EThermalPalette::Custom ? INDEX_NONE : static_cast<int32>(Palette) - 1;
+	Settings.Cold = Cold;
+	Settings.Mid = Mid;
+	Settings.Hot = Hot;
+
+	return Settings;
+}
+
+#if WITH_EDITOR
+void AThermalController::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, ThermalCameraActive)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::ThermalCameraToggle);
+		BroadcastThermalModeChanged();
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, ThermalCameraRangeMin) || PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, ThermalCameraRangeMax)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::BackgroundTemperature | EThermalSettingsDirty::SkyTemperature);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, BackgroundTemperature)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::BackgroundTemperature);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, SkyTemperature)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::SkyTemperature);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, Blur)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::Blur);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, NoiseAmount)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseAmount);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, NoiseSize)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseSize);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, NoiseMode)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseMode);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, SensorResolution) || PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, SensorUpscale)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::SensorResolution);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, Cold)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::Cold);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, Mid)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::Mid);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, Hot)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::Hot);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AThermalController, Palette)) {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::Palette);
+	}
+	else {
+		MarkThermalSettingsDirty(EThermalSettingsDirty::All);
+	}
+}
+#endif
+
+void AThermalController::SetThermalCameraActive(const bool bActive)
+{
+	if (ThermalCameraActive == bActive) return;
+
+	ThermalCameraActive = bActive;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::ThermalCameraToggle);
+	BroadcastThermalModeChanged();
+}
+
+void AThermalController::BroadcastThermalModeChanged()
+{
+	OnThermalModeChanged.Broadcast(ThermalCameraActive);
+}
+
+void AThermalController::GetSunHeating(FVector3f& OutDirectionToSun, float& OutIntensity) const
+{
+	if (Sun) {
+		//A directional light shines along its forward vector
+		OutDirectionToSun = FVector3f(-Sun->GetActorForwardVector());
+	}
+	else {
+		//Half a turn from sunrise at 6 to sunset at 18, below the horizon the rest of the day
+		const float Elevation = (TimeOfDay - 6.0f) / 12.0f * UE_PI;
+		const float Azimuth = FMath::DegreesToRadians(SunAzimuth);
+		const float Horizontal = FMath::Cos(Elevation);
+		OutDirectionToSun = FVector3f(Horizontal * FMath::Cos(Azimuth), Horizontal * FMath::Sin(Azimuth), FMath::Sin(Elevation));
+	}
+
+	//The sun heats less the lower it is, and not at all below the horizon
+	OutIntensity = SunIntensity * FMath::Max(OutDirectionToSun.Z, 0.0f);
+}
+
+void AThermalController::SetThermalCameraRangeMin(const float Value)
+{
+	if (ThermalCameraRangeMin == Value) return;
+
+	ThermalCameraRangeMin = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::BackgroundTemperature | EThermalSettingsDirty::SkyTemperature);
+}
+
+void AThermalController::SetThermalCameraRangeMax(const float Value)
+{
+	if (ThermalCameraRangeMax == Value) return;
+
+	ThermalCameraRangeMax = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::BackgroundTemperature | EThermalSettingsDirty::SkyTemperature);
+}
+
+void AThermalController::SetBackgroundTemperature(const float Value)
+{
+	if (BackgroundTemperature == Value) return;
+
+	BackgroundTemperature = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::BackgroundTemperature);
+}
+
+void AThermalController::SetSkyTemperature(const float Value)
+{
+	if (SkyTemperature == Value) return;
+
+	SkyTemperature = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::SkyTemperature);
+}
+
+void AThermalController::SetBlur(const float Value)
+{
+	if (Blur == Value) return;
+
+	Blur = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::Blur);
+}
+
+void AThermalController::SetNoiseSize(const float Value)
+{
+	if (NoiseSize == Value) return;
+
+	NoiseSize = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseSize);
+}
+
+void AThermalController::SetSensorResolution(const FIntPoint Value)
+{
+	if (SensorResolution == Value) return;
+
+	SensorResolution = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::SensorResolution);
+}
+
+void AThermalController::SetSensorUpscale(const EThermalSensorUpscale Value)
+{
+	if (SensorUpscale == Value) return;
+
+	SensorUpscale = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::SensorResolution);
+}
+
+void AThermalController::SetNoiseAmount(const float Value)
+{
+	if (NoiseAmount == Value) return;
+
+	NoiseAmount = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseAmount);
+}
+
+void AThermalController::SetNoiseMode(const EThermalNoiseMode Value)
+{
+	if (NoiseMode == Value) return;
+
+	NoiseMode = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::NoiseMode);
+}
+
+void AThermalController::SetCold(const FLinearColor Value)
+{
+	if (Cold == Value) return;
+
+	Cold = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::Cold);
+}
+
+void AThermalController::SetMid(const FLinearColor Value)
+{
+	if (Mid == Value) return;
+
+	Mid = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::Mid);
+}
+
+void AThermalController::SetHot(const FLinearColor Value)
+{
+	if (Hot == Value) return;
+
+	Hot = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::Hot);
+}
+
+void AThermalController::SetPalette(const EThermalPalette Value)
+{
+	if (Palette == Value) return;
+
+	Palette = Value;
+	MarkThermalSettingsDirty(EThermalSettingsDirty::Palette);
+}
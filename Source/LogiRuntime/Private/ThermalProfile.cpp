@@ -0,0 +1,98 @@
+#include "ThermalProfile.h"
+
+#include "Curves/CurveFloat.h"
+#include "ThermalWorldSubsystem.h"
+
+void UThermalProfile::PostLoad()
+{
+	Super::PostLoad();
+
+	//The curve keys have to be loaded before they are sampled
+	if (Curve) {
+		Curve->ConditionalPostLoad();
+	}
+
+	Bake();
+
+#if WITH_EDITOR
+	BindCurveUpdate();
+#endif
+}
+
+#if WITH_EDITOR
+void UThermalProfile::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	//Stop following the curve that is about to be replaced
+	if (Curve && CurveUpdateHandle.IsValid()) {
+		Curve->OnUpdateCurve.Remove(CurveUpdateHandle);
+	}
+	CurveUpdateHandle.Reset();
+}
+
+void UThermalProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BindCurveUpdate();
+	Rebake();
+}
+
+void UThermalProfile::BindCurveUpdate()
+{
+	if (Curve && !CurveUpdateHandle.IsValid()) {
+		CurveUpdateHandle = Curve->OnUpdateCurve.AddWeakLambda(this, [this](UCurveBase*, EPropertyChangeType::Type)
+		{
+			Rebake();
+		});
+	}
+}
+
+void UThermalProfile::Rebake()
+{
+	//Edits during PIE can land while the simulation task of a playing world reads the table
+	UThermalWorldSubsystem::WaitForSimulationInAllWorlds();
+	Bake();
+
+	//Playing entries scale their time by the duration they started with
+	UThermalWorldSubsystem::RefreshProfileInAllWorlds(*this);
+}
+#endif
+
+void UThermalProfile::Bake()
+{
+	//Baked aside and swapped in at the end, so the table is never read half written or resized
+	TArray<float> NewLUT;
+	NewLUT.SetNumZeroed(LUTSize);
+	float NewDuration = 0.0f;
+
+	if (Curve) {
+		//The table starts at time 0 so a profile always starts playing from its first sample
+		float MinTime = 0.0f;
+		float MaxTime = 0.0f;
+		Curve->GetTimeRange(MinTime, MaxTime);
+		NewDuration = FMath::Max(MaxTime, 0.0f);
+
+		for (int32 Sample = 0; Sample < LUTSize; ++Sample) {
+			const float Time = NewDuration * Sample / (LUTSize - 1);
+			NewLUT[Sample] = Curve->GetFloatValue(Time);
+		}
+	}
+
+	LUT = MoveTemp(NewLUT);
+	Duration = NewDuration;
+}
+
+float UThermalProfile::Evaluate(float Time) const
+{
+	if (LUT.Num() != LUTSize) return 0.0f;
+	if (Duration <= 0.0f) return LUT[0];
+
+	Time = bLoop ? FMath::Fmod(FMath::Max(Time, 0.0f), Duration) : FMath::Clamp(Time, 0.0f, Duration);
+
+	const float Coordinate = Time / Duration * (LUTSize - 1);
+	const int32 Sample = FMath::Min(FMath::FloorToInt32(Coordinate), LUTSize - 2);
+
+	return FMath::Lerp(LUT[Sample], LUT[Sample + 1], Coordinate - Sample);
+}
@@ -0,0 +1,126 @@
+#include "ThermalSignificance.h"
+
+#include "Components/MeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "ThermalComponent.h"
+
+static TAutoConsoleVariable<bool> CVarThermalSignificanceEnabled(
+	TEXT("Logi.Thermal.Significance.Enabled"),
+	true,
+	TEXT("Update thermal components less often the further away and smaller they are, and freeze the ones that are not rendered."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSignificanceEveryFrameDistance(
+	TEXT("Logi.Thermal.Significance.EveryFrameDistance"),
+	2000.0f,
+	TEXT("Thermal components closer than this to a view are updated every frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSignificanceEvery4thFrameDistance(
+	TEXT("Logi.Thermal.Significance.Every4thFrameDistance"),
+	6000.0f,
+	TEXT("Thermal components closer than this to a view are updated every 4th frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSignificanceEvery16thFrameDistance(
+	TEXT("Logi.Thermal.Significance.Every16thFrameDistance"),
+	15000.0f,
+	TEXT("Thermal components closer than this to a view are updated every 16th frame, components further away are frozen."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSignificanceMinScreenSize(
+	TEXT("Logi.Thermal.Significance.MinScreenSize"),
+	0.005f,
+	TEXT("Thermal components with a bounds radius to view distance ratio below this are frozen."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSignificanceRecentlyRenderedSeconds(
+	TEXT("Logi.Thermal.Significance.RecentlyRenderedSeconds"),
+	0.5f,
+	TEXT("Thermal components none of whose meshes were rendered within this many seconds are frozen."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarThermalSignificanceEvaluationsPerFrame(
+	TEXT("Logi.Thermal.Significance.EvaluationsPerFrame"),
+	1024,
+	TEXT("Number of thermal components whose significance is evaluated each frame, round robin."),
+	ECVF_Default);
+
+namespace ThermalSignificance
+{
+	EThermalSignificance Evaluate(const UThermalComponent& Component, const TConstArrayView<FVector> ViewLocations)
+	{
+		const float RecentlyRenderedSeconds = CVarThermalSignificanceRecentlyRenderedSeconds.GetValueOnGameThread();
+
+		bool bWasRecentlyRendered = false;
+		float ClosestDistanceSquared = TNumericLimits<float>::Max();
+		float BoundsRadius = 0.0f;
+
+		//Use the closest mesh of the component to the closest view
+		for (const FThermalMeshMaterials& Meshes : Component.GetThermalMeshes()) {
+			const UMeshComponent* MeshComponent = Meshes.Mesh.Get();
+			if (!MeshComponent) continue;
+
+			bWasRecentlyRendered |= MeshComponent->WasRecentlyRendered(RecentlyRenderedSeconds);
+
+			const FBoxSphereBounds& Bounds = MeshComponent->Bounds;
+			for (const FVector& ViewLocation : ViewLocations) {
+				const float DistanceSquared = static_cast<float>(FVector::DistSquared(Bounds.Origin, ViewLocation));
+
+				if (DistanceSquared < ClosestDistanceSquared) {
+					ClosestDistanceSquared = DistanceSquared;
+					BoundsRadius = static_cast<float>(Bounds.SphereRadius);
+				}
+			}
+		}
+
+		if (!bWasRecentlyRendered || ViewLocations.Num() == 0) {
+			return EThermalSignificance::Frozen;
+		}
+
+		const float Distance = FMath::Sqrt(ClosestDistanceSquared);
+
+		//Approximate screen size, the bounds radius relative to the view distance
+		if (BoundsRadius / FMath::Max(Distance, 1.0f) < CVarThermalSignificanceMinScreenSize.GetValueOnGameThread()) {
+			return EThermalSignificance::Frozen;
+		}
+
+		if (Distance < CVarThermalSignificanceEveryFrameDistance.GetValueOnGameThread()) {
+			return EThermalSignificance::EveryFrame;
+		}
+
+		if (Distance < CVarThermalSignificanceEvery4thFrameDistance.GetValueOnGameThread()) {
+			return EThermalSignificance::Every4thFrame;
+		}
+
+		if (Distance < CVarThermalSignificanceEvery16thFrameDistance.GetValueOnGameThread()) {
+			return EThermalSignificance::Every16thFrame;
+		}
+
+		return EThermalSignificance::Frozen;
+	}
+
+	bool ShouldUpdate(const EThermalSignificance Significance, const int32 Index, const uint64 FrameNumber)
+	{
+		switch (Significance) {
+		case EThermalSignificance::EveryFrame:
+			return true;
+		case EThermalSignificance::Every4thFrame:
+			return ((FrameNumber + Index) & 3) == 0;
+		case EThermalSignificance::Every16thFrame:
+			return ((FrameNumber + Index) & 15) == 0;
+		default:
+			return false;
+		}
+	}
+
+	int32 GetEvaluationsPerFrame()
+	{
+		return FMath::Max(CVarThermalSignificanceEvaluationsPerFrame.GetValueOnGameThread(), 1);
+	}
+
+	bool IsEnabled()
+	{
+		return CVarThermalSignificanceEnabled.GetValueOnGameThread();
+	}
+}
@@ -0,0 +1,156 @@
+#include "ThermalSpatialHash.h"
+
+int32 FThermalSpatialHash::Add()
+{
+	const int32 Index = Locations.AddZeroed();
+	EntryCells.AddZeroed();
+	HashedEntries.Add(false);
+
+	return Index;
+}
+
+void FThermalSpatialHash::RemoveAtSwap(const int32 Index)
+{
+	const int32 LastIndex = Locations.Num() - 1;
+
+	Remove(Index);
+
+	//The last entry takes the removed slot, its cell has to refer to the new index
+	if (Index != LastIndex && HashedEntries[LastIndex]) {
+		TArray<int32>& Cell = Cells.FindChecked(EntryCells[LastIndex]);
+		Cell[Cell.IndexOfByKey(LastIndex)] = Index;
+	}
+
+	HashedEntries[Index] = HashedEntries[LastIndex];
+	HashedEntries.RemoveAt(LastIndex);
+	Locations.RemoveAtSwap(Index, 1, false);
+	EntryCells.RemoveAtSwap(Index, 1, false);
+}
+
+void FThermalSpatialHash::Reset()
+{
+	Cells.Reset();
+	Locations.Reset();
+	EntryCells.Reset();
+	HashedEntries.Reset();
+	NumHashedEntries = 0;
+}
+
+void FThermalSpatialHash::Update(const int32 Index, const FVector& Location)
+{
+	Locations[Index] = Location;
+
+	const FIntVector Cell = GetCell(Location);
+
+	if (!HashedEntries[Index]) {
+		HashedEntries[Index] = true;
+		++NumHashedEntries;
+	}
+	//Most entries stay in their cell between frames
+	else if (EntryCells[Index] == Cell) {
+		return;
+	}
+	else {
+		RemoveFromCell(Index, EntryCells[Index]);
+	}
+
+	EntryCells[Index] = Cell;
+	AddToCell(Index, Cell);
+}
+
+void FThermalSpatialHash::Remove(const int32 Index)
+{
+	if (!HashedEntries[Index]) return;
+
+	RemoveFromCell(Index, EntryCells[Index]);
+	HashedEntries[Index] = false;
+	--NumHashedEntries;
+}
+
+void FThermalSpatialHash::SetCellSize(const float InCellSize)
+{
+	const float NewCellSize = FMath::Max(InCellSize, 1.0f);
+	if (CellSize == NewCellSize) return;
+
+	CellSize = NewCellSize;
+	Cells.Reset();
+
+	for (int32 Index = HashedEntries.FindFrom(true, 0); Index != INDEX_NONE; Index = HashedEntries.FindFrom(true, Index + 1)) {
+		EntryCells[Index] = GetCell(Locations[Index]);
+		AddToCell(Index, EntryCells[Index]);
+	}
+}
+
+void FThermalSpatialHash::FindNeighbours(const int32 Index, const float Radius, const int32 MaxNeighbours, TArray<int32, TInlineAllocator<16>>& OutNeighbours, TArray<float, TInlineAllocator<16>>& OutDistances) const
+{
+	OutNeighbours.Reset();
+	OutDistances.Reset();
+
+	if (!HashedEntries[Index] || MaxNeighbours <= 0) return;
+
+	const FVector& Location = Locations[Index];
+	const FIntVector MinCell = GetCell(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Location + FVector(Radius));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X) {
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y) {
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z) {
+				const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (!Cell) continue;
+
+				for (const int32 Other : *Cell) {
+					if (Other == Index) continue;
+
+					const float DistanceSquared = static_cast<float>(FVector::DistSquared(Location, Locations[Other]));
+					if (DistanceSquared > RadiusSquared) continue;
+
+					//Keep the nearest neighbours sorted, the farthest one drops out once the cap is reached
+					int32 Insert = OutDistances.Num();
+					while (Insert > 0 && OutDistances[Insert - 1] > DistanceSquared) {
+						--Insert;
+					}
+
+					if (Insert >= MaxNeighbours) continue;
+
+					OutNeighbours.Insert(Other, Insert);
+					OutDistances.Insert(DistanceSquared, Insert);
+
+					if (OutNeighbours.Num() > MaxNeighbours) {
+						OutNeighbours.Pop(false);
+						OutDistances.Pop(false);
+					}
+				}
+			}
+		}
+	}
+
+	for (float& Distance : OutDistances) {
+		Distance = FMath::Sqrt(Distance);
+	}
+}
+
+FIntVector FThermalSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void FThermalSpatialHash::AddToCell(const int32 Index, const FIntVector& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void FThermalSpatialHash::RemoveFromCell(const int32 Index, const FIntVector& Cell)
+{
+	TArray<int32>* Entries = Cells.Find(Cell);
+	if (!Entries) return;
+
+	Entries->RemoveSingleSwap(Index, false);
+
+	if (Entries->Num() == 0) {
+		Cells.Remove(Cell);
+	}
+}
@@ -0,0 +1,698 @@
+#include "ThermalTemperatureStore.h"
+
+#include "Async/ParallelFor.h"
+#include "ThermalAmbientVolume.h"
+#include "ThermalProfile.h"
+#include "ThermalSpatialHash.h"
+#include "ThermalStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Thermal normalize"), STAT_LogiThermalNormalize, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal transient"), STAT_LogiThermalTransient, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal profiles"), STAT_LogiThermalProfiles, STATGROUP_Logi);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Thermal profiles playing"), STAT_LogiThermalProfilesPlaying, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal solar heating"), STAT_LogiThermalSolar, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal heat exchange"), STAT_LogiThermalHeatExchange, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal ambient sampling"), STAT_LogiThermalAmbientSampling, STATGROUP_Logi);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Thermal actors heating or cooling"), STAT_LogiThermalTransientActors, STATGROUP_Logi);
+
+namespace
+{
+	// Entries per simulation task, a multiple of the bit array word size so no two tasks write the same word of PriorityEntries
+	constexpr int32 TransientChunkSize = 1024;
+	static_assert(TransientChunkSize % NumBitsPerDWORD == 0, "Transient chunks must not share bit array words");
+
+	// Temperatures closer than this to their target snap to it, settled entries stop being sent to the GPU
+	constexpr float SettledTemperatureTolerance = 0.01f;
+
+	float ToRate(const float TimeConstant)
+	{
+		return TimeConstant > 0.0f ? 1.0f / TimeConstant : 0.0f;
+	}
+}
+
+int32 FThermalTemperatureStore::Add(const float BaseTemperature, const float CurrentTemperature, const float MaxTemperature)
+{
+	const int32 Index = Base.Add(BaseTemperature);
+	Current.Add(CurrentTemperature);
+	PublishedCurrent.Add(CurrentTemperature);
+	Max.Add(MaxTemperature);
+
+	NormalizedBase.AddZeroed();
+	NormalizedCurrent.AddZeroed();
+	NormalizedMax.AddZeroed();
+
+	HeatingRate.Add(0.0f);
+	CoolingRate.Add(0.0f);
+	ActiveEntries.Add(false);
+	CoolToAmbientEntries.Add(false);
+	AmbientOffset.Add(0.0f);
+	EntryProfileSlots.Add(INDEX_NONE);
+
+	SolarAbsorptivity.Add(0.0f);
+	SolarNormalX.Add(0.0f);
+	SolarNormalY.Add(0.0f);
+	SolarNormalZ.Add(1.0f);
+	SolarHeat.Add(0.0f);
+	Conductivity.Add(1.0f);
+
+	PriorityEntries.Add(true);
+	DirtyEntries.Add(false);
+	FrozenEntries.Add(false);
+	++NumPendingEntries;
+	bNeedsNormalize = true;
+
+	return Index;
+}
+
+void FThermalTemperatureStore::RemoveAtSwap(const int32 Index)
+{
+	const int32 LastIndex = Base.Num() - 1;
+
+	if (PriorityEntries[Index] || DirtyEntries[Index]) {
+		--NumPendingEntries;
+	}
+
+	if (FrozenEntries[Index]) {
+		--NumFrozenEntries;
+	}
+
+	if (HeatingRate[Index] > 0.0f || CoolingRate[Index] > 0.0f) {
+		--NumTransientEntries;
+	}
+
+	if (SolarAbsorptivity[Index] > 0.0f) {
+		--NumSolarEntries;
+	}
+
+	SolarAbsorptivity.RemoveAtSwap(Index, 1, false);
+	SolarNormalX.RemoveAtSwap(Index, 1, false);
+	SolarNormalY.RemoveAtSwap(Index, 1, false);
+	SolarNormalZ.RemoveAtSwap(Index, 1, false);
+	SolarHeat.RemoveAtSwap(Index, 1, false);
+	Conductivity.RemoveAtSwap(Index, 1, false);
+
+	//Stop the profile of the removed entry first, then point the slot of the moved entry at its new index
+	PlayProfile(Index, nullptr);
+
+	EntryProfileSlots[Index] = EntryProfileSlots[LastIndex];
+	EntryProfileSlots.RemoveAt(LastIndex, 1, false);
+
+	if (Index != LastIndex && EntryProfileSlots[Index] != INDEX_NONE) {
+		PlayingEntries[EntryProfileSlots[Index]] = Index;
+	}
+
+	ActiveEntries[Index] = ActiveEntries[LastIndex];
+	ActiveEntries.RemoveAt(LastIndex);
+	CoolToAmbientEntries[Index] = CoolToAmbientEntries[LastIndex];
+	CoolToAmbientEntries.RemoveAt(LastIndex);
+	AmbientOffset.RemoveAtSwap(Index, 1, false);
+	HeatingRate.RemoveAtSwap(Index, 1, false);
+	CoolingRate.RemoveAtSwap(Index, 1, false);
+
+	PriorityEntries[Index] = PriorityEntries[LastIndex];
+	PriorityEntries.RemoveAt(LastIndex);
+	DirtyEntries[Index] = DirtyEntries[LastIndex];
+	DirtyEntries.RemoveAt(LastIndex);
+	FrozenEntries[Index] = FrozenEntries[LastIndex];
+	FrozenEntries.RemoveAt(LastIndex);
+
+	Base.RemoveAtSwap(Index, 1, false);
+	Current.RemoveAtSwap(Index, 1, false);
+	PublishedCurrent.RemoveAtSwap(Index, 1, false);
+	Max.RemoveAtSwap(Index, 1, false);
+
+	NormalizedBase.RemoveAtSwap(Index, 1, false);
+	NormalizedCurrent.RemoveAtSwap(Index, 1, false);
+	NormalizedMax.RemoveAtSwap(Index, 1, false);
+}
+
+void FThermalTemperatureStore::Reset()
+{
+	Base.Reset();
+	Current.Reset();
+	PublishedCurrent.Reset();
+	Max.Reset();
+
+	NormalizedBase.Reset();
+	NormalizedCurrent.Reset();
+	NormalizedMax.Reset();
+
+	HeatingRate.Reset();
+	CoolingRate.Reset();
+	ActiveEntries.Reset();
+	CoolToAmbientEntries.Reset();
+	AmbientOffset.Reset();
+	NumTransientEntries = 0;
+
+	SolarAbsorptivity.Reset();
+	SolarNormalX.Reset();
+	SolarNormalY.Reset();
+	SolarNormalZ.Reset();
+	SolarHeat.Reset();
+	Conductivity.Reset();
+	NumSolarEntries = 0;
+
+	PlayingEntries.Reset();
+	PlayingTimes.Reset();
+	PlayingLUTScales.Reset();
+	PlayingProfiles.Reset();
+	EntryProfileSlots.Reset();
+	SET_DWORD_STAT(STAT_LogiThermalProfilesPlaying, 0);
+
+	PriorityEntries.Reset();
+	DirtyEntries.Reset();
+	NumPendingEntries = 0;
+	FrozenEntries.Reset();
+	NumFrozenEntries = 0;
+	bNeedsNormalize = false;
+}
+
+void FThermalTemperatureStore::SetTemperatures(const int32 Index, const float BaseTemperature, const float CurrentTemperature, const float MaxTemperature)
+{
+	if (Base[Index] == BaseTemperature && Current[Index] == CurrentTemperature && Max[Index] == MaxTemperature) return;
+
+	Base[Index] = BaseTemperature;
+	Current[Index] = CurrentTemperature;
+	PublishedCurrent[Index] = CurrentTemperature;
+	Max[Index] = MaxTemperature;
+
+	MarkPriority(Index);
+	bNeedsNormalize = true;
+}
+
+void FThermalTemperatureStore::MarkPriority(const int32 Index)
+{
+	//Frozen entries are sent in front once they thaw
+	if (FrozenEntries[Index]) return;
+
+	if (!PriorityEntries[Index] && !DirtyEntries[Index]) {
+		++NumPendingEntries;
+	}
+
+	PriorityEntries[Index] = true;
+}
+
+bool FThermalTemperatureStore::MarkMoved(const int32 Index)
+{
+	if (PriorityEntries[Index] || FrozenEntries[Index]) return false;
+
+	PriorityEntries[Index] = true;
+	return !DirtyEntries[Index];
+}
+
+void FThermalTemperatureStore::SetTransient(const int32 Index, const float HeatingTimeConstant, const float CoolingTimeConstant, const bool bCoolToAmbient)
+{
+	const bool bWasTransient = HeatingRate[Index] > 0.0f || CoolingRate[Index] > 0.0f;
+
+	HeatingRate[Index] = ToRate(HeatingTimeConstant);
+	CoolingRate[Index] = ToRate(CoolingTimeConstant);
+	CoolToAmbientEntries[Index] = bCoolToAmbient;
+
+	const bool bIsTransient = HeatingRate[Index] > 0.0f || CoolingRate[Index] > 0.0f;
+	NumTransientEntries += static_cast<int32>(bIsTransient) - static_cast<int32>(bWasTransient);
+}
+
+void FThermalTemperatureStore::SetActive(const int32 Index, const bool bActive)
+{
+	ActiveEntries[Index] = bActive;
+}
+
+void FThermalTemperatureStore::Simulate(const float DeltaTime, const float AmbientTemperature)
+{
+	if (NumTransientEntries == 0 || DeltaTime <= 0.0f) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalTransient);
+
+	const int32 Count = Base.Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(Count, TransientChunkSize);
+	std::atomic<int32> NumMovedEntries = 0;
+	std::atomic<int32> NumNewPendingEntries = 0;
+
+	//First order response: the temperature closes the fraction 1 - exp(-dt / tau) of the gap to its target in one call.
+	//The world subsystem calls this once per fixed step from its simulation task, the chunks of one step run in parallel.
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const int32 StartIndex = ChunkIndex * TransientChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + TransientChunkSize, Count);
+		int32 NumMoved = 0;
+		int32 NumNewPending = 0;
+
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index) {
+			const bool bActive = ActiveEntries[Index];
+			const float Rate = bActive ? HeatingRate[Index] : CoolingRate[Index];
+			if (Rate <= 0.0f) continue;
+
+			const float Target = bActive ? Max[Index] : (CoolToAmbientEntries[Index] ? AmbientTemperature + AmbientOffset[Index] : Base[Index]);
+			const float Gap = Target - Current[Index];
+			if (FMath::Abs(Gap) <= SettledTemperatureTolerance) continue;
+
+			const float Remaining = Gap * FMath::Exp(-Rate * DeltaTime);
+			Current[Index] = FMath::Abs(Remaining) <= SettledTemperatureTolerance ? Target : Target - Remaining;
+			++NumMoved;
+
+			if (MarkMoved(Index)) {
+				++NumNewPending;
+			}
+		}
+
+		NumMovedEntries += NumMoved;
+		NumNewPendingEntries += NumNewPending;
+	});
+
+	NumPendingEntries += NumNewPendingEntries;
+	bNeedsNormalize |= NumMovedEntries > 0;
+
+	INC_DWORD_STAT_BY(STAT_LogiThermalTransientActors, NumMovedEntries);
+}
+
+void FThermalTemperatureStore::SampleAmbient(const FThermalAmbientVolume& AmbientVolume, const TConstArrayView<FVector3f> Locations)
+{
+	check(Locations.Num() == Base.Num());
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalAmbientSampling);
+
+	const int32 Count = Base.Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(Count, TransientChunkSize);
+
+	//One brick lookup and eight reads per entry, the offsets only move the cooling targets so nothing is marked dirty here
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const int32 StartIndex = ChunkIndex * TransientChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + TransientChunkSize, Count);
+
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index) {
+			AmbientOffset[Index] = CoolToAmbientEntries[Index] ? AmbientVolume.Sample(Locations[Index]) : 0.0f;
+		}
+	});
+}
+
+void FThermalTemperatureStore::SetSolar(const int32 Index, float Absorptivity, const FVector3f& SurfaceNormal)
+{
+	Absorptivity = FMath::Clamp(Absorptivity, 0.0f, 1.0f);
+	NumSolarEntries += static_cast<int32>(Absorptivity > 0.0f) - static_cast<int32>(SolarAbsorptivity[Index] > 0.0f);
+
+	const FVector3f Normal = SurfaceNormal.GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+	SolarAbsorptivity[Index] = Absorptivity;
+	SolarNormalX[Index] = Normal.X;
+	SolarNormalY[Index] = Normal.Y;
+	SolarNormalZ[Index] = Normal.Z;
+
+	//Shade entries that no longer absorb, the next solar pass gives the rest their new heating
+	if (Absorptivity == 0.0f && SolarHeat[Index] != 0.0f) {
+		SolarHeat[Index] = 0.0f;
+		MarkPriority(Index);
+		bNeedsNormalize = true;
+	}
+}
+
+bool FThermalTemperatureStore::SetSolarNormal(const int32 Index, const FVector3f& SurfaceNormal, const float MinCos)
+{
+	const FVector3f Normal = SurfaceNormal.GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+	if (Normal.X * SolarNormalX[Index] + Normal.Y * SolarNormalY[Index] + Normal.Z * SolarNormalZ[Index] >= MinCos) return false;
+
+	SolarNormalX[Index] = Normal.X;
+	SolarNormalY[Index] = Normal.Y;
+	SolarNormalZ[Index] = Normal.Z;
+	return true;
+}
+
+void FThermalTemperatureStore::ApplySolarHeating(const FVector3f& DirectionToSun, const float Intensity)
+{
+	if (NumSolarEntries == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSolar);
+
+	const int32 Count = Base.Num();
+	SolarScratch.SetNumUninitialized(Count);
+
+	const float* RESTRICT NormalX = SolarNormalX.GetData();
+	const float* RESTRICT NormalY = SolarNormalY.GetData();
+	const float* RESTRICT NormalZ = SolarNormalZ.GetData();
+	const float* RESTRICT Absorptivity = SolarAbsorptivity.GetData();
+	float* RESTRICT Heat = SolarScratch.GetData();
+
+	//Heat = Intensity * Absorptivity * max(0, N . L), four entries per instruction
+	const VectorRegister4Float SunX = VectorSetFloat1(DirectionToSun.X);
+	const VectorRegister4Float SunY = VectorSetFloat1(DirectionToSun.Y);
+	const VectorRegister4Float SunZ = VectorSetFloat1(DirectionToSun.Z);
+	const VectorRegister4Float IntensityVector = VectorSetFloat1(Intensity);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Count; Index += 4) {
+		VectorRegister4Float Facing = VectorMultiply(VectorLoad(NormalX + Index), SunX);
+		Facing = VectorMultiplyAdd(VectorLoad(NormalY + Index), SunY, Facing);
+		Facing = VectorMultiplyAdd(VectorLoad(NormalZ + Index), SunZ, Facing);
+		Facing = VectorMax(Facing, VectorZeroFloat());
+
+		VectorStore(VectorMultiply(VectorMultiply(Facing, VectorLoad(Absorptivity + Index)), IntensityVector), Heat + Index);
+	}
+	for (; Index < Count; ++Index) {
+		const float Facing = FMath::Max(NormalX[Index] * DirectionToSun.X + NormalY[Index] * DirectionToSun.Y + NormalZ[Index] * DirectionToSun.Z, 0.0f);
+		Heat[Index] = Facing * Absorptivity[Index] * Intensity;
+	}
+
+	//Only entries whose heating moved by a visible amount are sent again
+	for (Index = 0; Index < Count; ++Index) {
+		if (FMath::Abs(Heat[Index] - SolarHeat[Index]) <= SettledTemperatureTolerance) continue;
+
+		SolarHeat[Index] = Heat[Index];
+		bNeedsNormalize = true;
+
+		if (MarkMoved(Index)) {
+			++NumPendingEntries;
+		}
+	}
+}
+
+void FThermalTemperatureStore::ApplySolarHeating(const TConstArrayView<int32> Indices, const FVector3f& DirectionToSun, const float Intensity)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSolar);
+
+	for (const int32 Index : Indices) {
+		const float Facing = FMath::Max(SolarNormalX[Index] * DirectionToSun.X + SolarNormalY[Index] * DirectionToSun.Y + SolarNormalZ[Index] * DirectionToSun.Z, 0.0f);
+		const float Heat = Facing * SolarAbsorptivity[Index] * Intensity;
+		if (FMath::Abs(Heat - SolarHeat[Index]) <= SettledTemperatureTolerance) continue;
+
+		SolarHeat[Index] = Heat;
+		bNeedsNormalize = true;
+
+		if (MarkMoved(Index)) {
+			++NumPendingEntries;
+		}
+	}
+}
+
+void FThermalTemperatureStore::PlayProfile(const int32 Index, const UThermalProfile* Profile)
+{
+	int32 Slot = EntryProfileSlots[Index];
+
+	if (!Profile || Profile->GetLUT().Num() != UThermalProfile::LUTSize) {
+		if (Slot == INDEX_NONE) return;
+
+		//Move the last playing entry into the freed slot
+		const int32 LastSlot = PlayingEntries.Num() - 1;
+		if (Slot != LastSlot) {
+			EntryProfileSlots[PlayingEntries[LastSlot]] = Slot;
+		}
+
+		PlayingEntries.RemoveAtSwap(Slot, 1, false);
+		PlayingTimes.RemoveAtSwap(Slot, 1, false);
+		PlayingLUTScales.RemoveAtSwap(Slot, 1, false);
+		PlayingProfiles.RemoveAtSwap(Slot, 1, false);
+		EntryProfileSlots[Index] = INDEX_NONE;
+
+		SET_DWORD_STAT(STAT_LogiThermalProfilesPlaying, PlayingEntries.Num());
+		return;
+	}
+
+	if (Slot == INDEX_NONE) {
+		Slot = PlayingEntries.Add(Index);
+		PlayingTimes.AddZeroed();
+		PlayingLUTScales.AddZeroed();
+		PlayingProfiles.Add(nullptr);
+		EntryProfileSlots[Index] = Slot;
+	}
+
+	PlayingTimes[Slot] = 0.0f;
+	PlayingLUTScales[Slot] = Profile->GetDuration() > 0.0f ? (UThermalProfile::LUTSize - 1) / Profile->GetDuration() : 0.0f;
+	PlayingProfiles[Slot] = Profile;
+
+	SET_DWORD_STAT(STAT_LogiThermalProfilesPlaying, PlayingEntries.Num());
+}
+
+void FThermalTemperatureStore::RefreshProfile(const UThermalProfile* Profile)
+{
+	if (!Profile) return;
+
+	//The scale from seconds to table samples was taken from the duration when the entries started playing
+	const float LUTScale = Profile->GetDuration() > 0.0f ? (UThermalProfile::LUTSize - 1) / Profile->GetDuration() : 0.0f;
+
+	for (int32 Slot = 0; Slot < PlayingProfiles.Num(); ++Slot) {
+		if (PlayingProfiles[Slot] == Profile) {
+			PlayingLUTScales[Slot] = LUTScale;
+		}
+	}
+}
+
+void FThermalTemperatureStore::AdvanceProfiles(const float DeltaTime)
+{
+	const int32 Count = PlayingEntries.Num();
+	if (Count == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalProfiles);
+
+	float* RESTRICT Times = PlayingTimes.GetData();
+	const float* RESTRICT Scales = PlayingLUTScales.GetData();
+	ProfileCoordinates.SetNumUninitialized(Count);
+	float* RESTRICT Coordinates = ProfileCoordinates.GetData();
+
+	//Advance every play time, four per instruction
+	const VectorRegister4Float DeltaVector = VectorSetFloat1(DeltaTime);
+	int32 Slot = 0;
+	for (; Slot + 4 <= Count; Slot += 4) {
+		VectorStore(VectorAdd(VectorLoad(Times + Slot), DeltaVector), Times + Slot);
+	}
+	for (; Slot < Count; ++Slot) {
+		Times[Slot] += DeltaTime;
+	}
+
+	//Looping profiles start over, the rest hold their last sample once the coordinate is clamped below
+	for (Slot = 0; Slot < Count; ++Slot) {
+		const float Duration = PlayingProfiles[Slot]->GetDuration();
+		if (Times[Slot] >= Duration && Duration > 0.0f && PlayingProfiles[Slot]->IsLooping()) {
+			Times[Slot] = FMath::Fmod(Times[Slot], Duration);
+		}
+	}
+
+	//Turn the play times into lookup table coordinates, four per instruction
+	const VectorRegister4Float LastSampleVector = VectorSetFloat1(static_cast<float>(UThermalProfile::LUTSize - 1));
+	for (Slot = 0; Slot + 4 <= Count; Slot += 4) {
+		VectorStore(VectorMin(VectorMultiply(VectorLoad(Times + Slot), VectorLoad(Scales + Slot)), LastSampleVector), Coordinates + Slot);
+	}
+	for (; Slot < Count; ++Slot) {
+		Coordinates[Slot] = FMath::Min(Times[Slot] * Scales[Slot], static_cast<float>(UThermalProfile::LUTSize - 1));
+	}
+
+	//Gather the two samples around each coordinate, there is no portable vector gather so this part stays scalar
+	TArray<int32, TInlineAllocator<8>> FinishedEntries;
+
+	for (Slot = 0; Slot < Count; ++Slot) {
+		const float* LUT = PlayingProfiles[Slot]->GetLUT().GetData();
+		const int32 Sample = FMath::Min(static_cast<int32>(Coordinates[Slot]), UThermalProfile::LUTSize - 2);
+		const float Blend = FMath::Lerp(LUT[Sample], LUT[Sample + 1], Coordinates[Slot] - Sample);
+
+		const int32 Index = PlayingEntries[Slot];
+		const float Temperature = FMath::Lerp(Base[Index], Max[Index], Blend);
+
+		if (Current[Index] != Temperature) {
+			Current[Index] = Temperature;
+			bNeedsNormalize = true;
+
+			if (MarkMoved(Index)) {
+				++NumPendingEntries;
+			}
+		}
+
+		if (Times[Slot] >= PlayingProfiles[Slot]->GetDuration() && !PlayingProfiles[Slot]->IsLooping()) {
+			FinishedEntries.Add(Index);
+		}
+	}
+
+	//The temperature stays at the last sample of a finished profile
+	for (const int32 Index : FinishedEntries) {
+		PlayProfile(Index, nullptr);
+	}
+}
+
+void FThermalTemperatureStore::SetProfileTime(const int32 Index, const float Time)
+{
+	const int32 Slot = EntryProfileSlots[Index];
+	if (Slot == INDEX_NONE) return;
+
+	PlayingTimes[Slot] = FMath::Max(Time, 0.0f);
+}
+
+void FThermalTemperatureStore::ExchangeHeat(const FThermalSpatialHash& SpatialHash, const float DeltaTime, const float Radius, const float Coefficient, const int32 MaxNeighbours)
+{
+	if (SpatialHash.NumHashed() == 0 || DeltaTime <= 0.0f || Radius <= 0.0f || Coefficient <= 0.0f) return;
+
+	check(SpatialHash.Num() == Base.Num());
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalHeatExchange);
+
+	const int32 Count = Base.Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(Count, TransientChunkSize);
+	HeatExchangeDelta.SetNumUninitialized(Count);
+
+	//Every entry relaxes toward the mean of its neighbours, weighted by closeness. The deltas are gathered from
+	//the temperatures before the exchange so the result does not depend on the order the chunks run in.
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const int32 StartIndex = ChunkIndex * TransientChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + TransientChunkSize, Count);
+		TArray<int32, TInlineAllocator<16>> Neighbours;
+		TArray<float, TInlineAllocator<16>> Distances;
+
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index) {
+			HeatExchangeDelta[Index] = 0.0f;
+			if (!SpatialHash.Contains(Index)) continue;
+
+			SpatialHash.FindNeighbours(Index, Radius, MaxNeighbours, Neighbours, Distances);
+
+			float WeightSum = 0.0f;
+			float WeightedGap = 0.0f;
+
+			for (int32 NeighbourIndex = 0; NeighbourIndex < Neighbours.Num(); ++NeighbourIndex) {
+				const float Weight = 1.0f - Distances[NeighbourIndex] / Radius;
+				WeightSum += Weight;
+				WeightedGap += Weight * (Current[Neighbours[NeighbourIndex]] - Current[Index]);
+			}
+
+			if (WeightSum <= 0.0f) continue;
+
+			//Exact response toward the weighted mean, never overshoots however long the step
+			HeatExchangeDelta[Index] = WeightedGap / WeightSum * (1.0f - FMath::Exp(-Coefficient * Conductivity[Index] * WeightSum * DeltaTime));
+		}
+	});
+
+	std::atomic<int32> NumNewPendingEntries = 0;
+	std::atomic<bool> bMoved = false;
+
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const int32 StartIndex = ChunkIndex * TransientChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + TransientChunkSize, Count);
+		int32 NumNewPending = 0;
+
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index) {
+			if (FMath::Abs(HeatExchangeDelta[Index]) <= SettledTemperatureTolerance) continue;
+
+			Current[Index] += HeatExchangeDelta[Index];
+			bMoved = true;
+
+			if (MarkMoved(Index)) {
+				++NumNewPending;
+			}
+		}
+
+		NumNewPendingEntries += NumNewPending;
+	});
+
+	NumPendingEntries += NumNewPendingEntries;
+	bNeedsNormalize |= bMoved;
+}
+
+void FThermalTemperatureStore::Publish()
+{
+	check(PublishedCurrent.Num() == Current.Num());
+
+	FMemory::Memcpy(PublishedCurrent.GetData(), Current.GetData(), Current.Num() * sizeof(float));
+}
+
+bool FThermalTemperatureStore::SetRange(const float InRangeMin, const float InRangeMax)
+{
+	if (RangeMin == InRangeMin && RangeMax == InRangeMax) return false;
+
+	RangeMin = InRangeMin;
+	RangeMax = InRangeMax;
+
+	//Every entry has to be sent again, the entries that already have priority stay in front and frozen ones wait for their thaw
+	DirtyEntries = FrozenEntries;
+	DirtyEntries.BitwiseNOT();
+	NumPendingEntries = DirtyEntries.Num() - NumFrozenEntries;
+	bNeedsNormalize = true;
+	return true;
+}
+
+bool FThermalTemperatureStore::Normalize()
+{
+	if (!bNeedsNormalize) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalNormalize);
+
+	const int32 Count = Base.Num();
+	NormalizeToRange(Base.GetData(), NormalizedBase.GetData(), Count, RangeMin, RangeMax);
+
+	//The camera shows the current temperature with the solar heating on top
+	if (NumSolarEntries > 0) {
+		SolarScratch.SetNumUninitialized(Count);
+		int32 Index = 0;
+		for (; Index + 4 <= Count; Index += 4) {
+			VectorStore(VectorAdd(VectorLoad(Current.GetData() + Index), VectorLoad(SolarHeat.GetData() + Index)), SolarScratch.GetData() + Index);
+		}
+		for (; Index < Count; ++Index) {
+			SolarScratch[Index] = Current[Index] + SolarHeat[Index];
+		}
+		NormalizeToRange(SolarScratch.GetData(), NormalizedCurrent.GetData(), Count, RangeMin, RangeMax);
+	}
+	else {
+		NormalizeToRange(Current.GetData(), NormalizedCurrent.GetData(), Count, RangeMin, RangeMax);
+	}
+	NormalizeToRange(Max.GetData(), NormalizedMax.GetData(), Count, RangeMin, RangeMax);
+
+	bNeedsNormalize = false;
+	return true;
+}
+
+void FThermalTemperatureStore::ClearDirty(const int32 Index)
+{
+	if (!PriorityEntries[Index] && !DirtyEntries[Index]) return;
+
+	PriorityEntries[Index] = false;
+	DirtyEntries[Index] = false;
+	--NumPendingEntries;
+}
+
+void FThermalTemperatureStore::Freeze(const int32 Index)
+{
+	if (!PriorityEntries[Index] && !DirtyEntries[Index]) return;
+
+	ClearDirty(Index);
+	FrozenEntries[Index] = true;
+	++NumFrozenEntries;
+}
+
+void FThermalTemperatureStore::Thaw(const int32 Index)
+{
+	if (!FrozenEntries[Index]) return;
+
+	FrozenEntries[Index] = false;
+	--NumFrozenEntries;
+	MarkPriority(Index);
+}
+
+void FThermalTemperatureStore::ThawAll()
+{
+	for (int32 Index = FrozenEntries.Find(true); NumFrozenEntries > 0 && Index != INDEX_NONE; Index = FrozenEntries.FindFrom(true, Index + 1)) {
+		Thaw(Index);
+	}
+}
+
+void FThermalTemperatureStore::NormalizeToRange(const float* RESTRICT Values, float* RESTRICT OutValues, const int32 Count, float InRangeMin, float InRangeMax)
+{
+	//An empty range maps everything below it to 0 and the rest to 1, like the blueprint node
+	if (InRangeMin == InRangeMax) {
+		for (int32 Index = 0; Index < Count; ++Index) {
+			OutValues[Index] = Values[Index] < InRangeMin ? 0.0f : 1.0f;
+		}
+		return;
+	}
+
+	if (InRangeMin > InRangeMax) {
+		Swap(InRangeMin, InRangeMax);
+	}
+
+	const float InvRange = 1.0f / (InRangeMax - InRangeMin);
+
+	//(Value - Min) / (Max - Min), four values at a time
+	const VectorRegister4Float RangeMinVector = VectorSetFloat1(InRangeMin);
+	const VectorRegister4Float InvRangeVector = VectorSetFloat1(InvRange);
+
+	const int32 VectorCount = Count & ~3;
+	int32 Index = 0;
+
+	for (; Index < VectorCount; Index += 4) {
+		const VectorRegister4Float Value = VectorLoad(Values + Index);
+		VectorStore(VectorMultiply(VectorSubtract(Value, RangeMinVector), InvRangeVector), OutValues + Index);
+	}
+
+	for (; Index < Count; ++Index) {
+		OutValues[Index] = (Values[Index] - InRangeMin) * InvRange;
+	}
+}
@@ -0,0 +1,1088 @@
+#include "ThermalWorldSubsystem.h"
+
+#include "Components/MeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "UObject/UObjectGlobals.h"
+#include "LogiSettings.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Serialization/MemoryReader.h"
+#include "SceneViewExtension.h"
+#include "Serialization/MemoryWriter.h"
+#include "ThermalComponent.h"
+#include "ThermalControllerActor.h"
+#include "ThermalProfile.h"
+#include "ThermalSceneViewExtension.h"
+#include "ThermalSignificance.h"
+#include "ThermalStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Thermal actor update"), STAT_LogiThermalActorUpdate, STATGROUP_Logi);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Thermal actors"), STAT_LogiThermalActors, STATGROUP_Logi);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Thermal actors updated"), STAT_LogiThermalActorsUpdated, STATGROUP_Logi);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Thermal update backlog"), STAT_LogiThermalUpdateBacklog, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal significance"), STAT_LogiThermalSignificance, STATGROUP_Logi);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Thermal actors frozen"), STAT_LogiThermalFrozen, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal spatial hash"), STAT_LogiThermalSpatialHash, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal simulation task"), STAT_LogiThermalSimulationTask, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal simulation wait"), STAT_LogiThermalSimulationWait, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal snapshot save"), STAT_LogiThermalSnapshotSave, STATGROUP_Logi);
+DECLARE_CYCLE_STAT(TEXT("Thermal snapshot restore"), STAT_LogiThermalSnapshotRestore, STATGROUP_Logi);
+
+static TAutoConsoleVariable<float> CVarThermalUpdateBudgetUs(
+	TEXT("Logi.Thermal.UpdateBudgetUs"),
+	500.0f,
+	TEXT("Time in microseconds the thermal update may spend sending temperatures to the GPU each frame.\n")
+	TEXT("Components that do not fit are updated on the next frames, round robin. 0 disables the budget."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalTransientHz(
+	TEXT("Logi.Thermal.Transient.Hz"),
+	30.0f,
+	TEXT("Fixed rate of the heating, cooling and heat exchange simulation, in steps per second.\n")
+	TEXT("The same steps run at any frame rate, so a capture and an interactive session get the same temperatures."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarThermalTransientAsync(
+	TEXT("Logi.Thermal.Transient.Async"),
+	true,
+	TEXT("Runs the simulation steps on the task graph, overlapping the next frame of the game thread.\n")
+	TEXT("Off runs them on the game thread during the thermal update, with the same results."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarThermalTransientMaxSteps(
+	TEXT("Logi.Thermal.Transient.MaxStepsPerFrame"),
+	8,
+	TEXT("Most fixed heating and cooling steps run in one frame, time beyond that is dropped after a hitch."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarThermalHeatExchangeEnabled(
+	TEXT("Logi.Thermal.HeatExchange.Enabled"),
+	true,
+	TEXT("Lets thermal actors with bExchangeHeat heat up and cool down their nearest neighbours."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalHeatExchangeRadius(
+	TEXT("Logi.Thermal.HeatExchange.Radius"),
+	500.0f,
+	TEXT("Distance in cm within which thermal actors exchange heat, also the cell size of the spatial hash."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalHeatExchangeCoefficient(
+	TEXT("Logi.Thermal.HeatExchange.Coefficient"),
+	0.1f,
+	TEXT("Rate per second at which a thermal actor closes the gap to the temperature of a touching neighbour."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarThermalHeatExchangeMaxNeighbours(
+	TEXT("Logi.Thermal.HeatExchange.MaxNeighbours"),
+	8,
+	TEXT("Most neighbours a thermal actor exchanges heat with, the nearest ones are kept."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalAmbientVoxelSize(
+	TEXT("Logi.Thermal.Ambient.VoxelSize"),
+	100.0f,
+	TEXT("Size in cm of a voxel of the ambient temperature volume, picked up by the first stamp into an empty volume."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarThermalSolarMinSunAngle(
+	TEXT("Logi.Thermal.Solar.MinSunAngle"),
+	0.5f,
+	TEXT("Degrees the sun, or the up vector of a movable sunlit thermal actor, has to turn before the solar heating of every sunlit thermal actor is recomputed."),
+	ECVF_Default);
+
+namespace
+{
+	// Parameters of M_Logi_ThermalMaterial
+	const FName CurrentTemperatureParameterName(TEXT("CurrentTemperature"));
+
+	// Parameters of M_Logi_ThermalMaterial_Skeletal, one hot mask of the material slot over the two section temperature vectors
+	const FName SectionMaskAParameterName(TEXT("ThermalSectionMaskA"));
+	const FName SectionMaskBParameterName(TEXT("ThermalSectionMaskB"));
+	const FName MaxTemperatureParameterName(TEXT("MaxTemperature"));
+	const FName BaseTemperatureParameterName(TEXT("BaseTemperature"));
+
+	// First bytes of every thermal snapshot, "LOGT"
+	constexpr uint32 ThermalSnapshotMagic = 0x4C4F4754;
+
+	// Add a version for every change to the snapshot layout, older snapshots stay readable
+	enum class EThermalSnapshotVersion : int32
+	{
+		Initial = 1,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	// Flags of one snapshot entry
+	constexpr uint8 ThermalSnapshotActive = 1 << 0;
+
+	constexpr float ThermalSnapshotQuantizationSteps = static_cast<float>(MAX_uint16);
+
+	// Maps every temperature to 16 bits over [RangeMin, RangeMax]
+	void QuantizeTemperatures(const TConstArrayView<float> Temperatures, const float RangeMin, const float RangeMax, TArray<float>& Scratch, TArray<uint16>& OutQuantized)
+	{
+		Scratch.SetNumUninitialized(Temperatures.Num());
+		FThermalTemperatureStore::NormalizeToRange(Temperatures.GetData(), Scratch.GetData(), Temperatures.Num(), RangeMin, RangeMax);
+
+		OutQuantized.SetNumUninitialized(Temperatures.Num());
+		for (int32 Index = 0; Index < Temperatures.Num(); ++Index) {
+			OutQuantized[Index] = static_cast<uint16>(FMath::RoundToInt32(FMath::Clamp(Scratch[Index], 0.0f, 1.0f) * ThermalSnapshotQuantizationSteps));
+		}
+	}
+
+	float DequantizeTemperature(const uint16 Quantized, const float RangeMin, const float RangeMax)
+	{
+		return FMath::Lerp(RangeMin, RangeMax, Quantized / ThermalSnapshotQuantizationSteps);
+	}
+
+	// Bytes every entry takes in the arrays of a snapshot
+	constexpr int64 ThermalSnapshotEntrySize = sizeof(FGuid) + 3 * sizeof(uint16) + sizeof(uint8) + sizeof(float);
+
+	// Reads one array written by TArray::BulkSerialize (element size, count, elements). The element size and count are
+	// checked against the snapshot before anything is allocated, so corrupt data can not ask for a huge allocation.
+	template<typename ElementType>
+	bool ReadSnapshotArray(FArchive& Reader, const int32 NumEntries, TArray<ElementType>& OutArray)
+	{
+		int32 ElementSize = 0;
+		int32 Num = 0;
+		Reader << ElementSize << Num;
+
+		if (Reader.IsError() || ElementSize != sizeof(ElementType) || Num != NumEntries) return false;
+
+		OutArray.SetNumUninitialized(Num);
+		Reader.Serialize(OutArray.GetData(), static_cast<int64>(Num) * sizeof(ElementType));
+		return !Reader.IsError();
+	}
+
+	// Everything one simulation task needs, read on the game thread before it is launched
+	struct FThermalSimulationSettings
+	{
+		int32 NumSteps = 0;
+		float StepSeconds = 0.0f;
+		float AmbientTemperature = 0.0f;
+		bool bExchangeHeat = false;
+		float HeatExchangeRadius = 0.0f;
+		float HeatExchangeCoefficient = 0.0f;
+		int32 HeatExchangeMaxNeighbours = 0;
+		bool bSampleAmbient = false;
+	};
+
+	void RunSimulation(FThermalTemperatureStore& TemperatureStore, const FThermalSpatialHash& SpatialHash, const FThermalAmbientVolume& AmbientVolume,
+		const TConstArrayView<FVector3f> AmbientLocations, const FThermalSimulationSettings& Settings)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_LogiThermalSimulationTask);
+
+		if (Settings.bSampleAmbient) {
+			TemperatureStore.SampleAmbient(AmbientVolume, AmbientLocations);
+		}
+
+		//One step at a time, so the heat exchange sees the same temperatures whatever the frame rate
+		for (int32 Step = 0; Step < Settings.NumSteps; ++Step) {
+			TemperatureStore.Simulate(Settings.StepSeconds, Settings.AmbientTemperature);
+
+			//Playing profiles override the heating and cooling of their actors
+			TemperatureStore.AdvanceProfiles(Settings.StepSeconds);
+
+			if (Settings.bExchangeHeat) {
+				TemperatureStore.ExchangeHeat(SpatialHash, Settings.StepSeconds, Settings.HeatExchangeRadius, Settings.HeatExchangeCoefficient, Settings.HeatExchangeMaxNeighbours);
+			}
+		}
+	}
+}
+
+void UThermalWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UThermalWorldSubsystem::WaitForSimulation);
+
+	//Inactive until the controller enables it, the first settings arrive with the first controller tick
+	if (GetDefault<ULogiSettings>()->UseThermalImageExtension()) {
+		ThermalImageExtension = FSceneViewExtensions::NewExtension<FThermalSceneViewExtension>(GetWorld());
+		BlueNoiseTexture = GetDefault<ULogiSettings>()->BlueNoiseTexture.LoadSynchronous();
+	}
+}
+
+void UThermalWorldSubsystem::Deinitialize()
+{
+	WaitForSimulation();
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+
+	for (UThermalComponent* Component : ThermalComponents) {
+		if (Component) {
+			Component->ThermalIndex = INDEX_NONE;
+		}
+	}
+
+	ThermalComponents.Empty();
+	ThermalControllers.Empty();
+	SkeletalSectionMaterials.Empty();
+	TemperatureStore.Reset();
+	SpatialHash.Reset();
+	UpdateCursor = 0;
+	SolarDirection = FVector3f::ZeroVector;
+	SolarIntensity = 0.0f;
+	bSolarDirty = false;
+	MovableSolarIndices.Empty();
+	MovableSolarSlots.Empty();
+	TurnedSolarIndices.Empty();
+	TransientTimeAccumulator = 0.0f;
+	SimulatedSteps = 0;
+	AmbientVolume.Reset();
+	AmbientLocations.Empty();
+	bAmbientVolumeChanged = false;
+	ThermalImageExtension.Reset();
+	BlueNoiseTexture = nullptr;
+
+	Significances.Empty();
+	SignificanceCursor = 0;
+	FMemory::Memzero(NumSignificances);
+
+	SET_DWORD_STAT(STAT_LogiThermalActors, 0);
+	SET_DWORD_STAT(STAT_LogiThermalUpdateBacklog, 0);
+
+	Super::Deinitialize();
+}
+
+bool UThermalWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	//Only game worlds run the thermal update, the editor world keeps the authored materials
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UThermalWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UThermalWorldSubsystem, STATGROUP_Tickables);
+}
+
+void UThermalWorldSubsystem::RegisterThermalComponent(UThermalComponent* Component)
+{
+	//Skip components that are already registered
+	if (!Component || Component->ThermalIndex != INDEX_NONE) return;
+
+	WaitForSimulation();
+
+	Component->ThermalIndex = ThermalComponents.Add(Component);
+	MovableSolarSlots.Add(INDEX_NONE);
+
+	const FThermalState& State = Component->GetThermalState();
+	const int32 Index = TemperatureStore.Add(State.BaseTemperature, State.CurrentTemperature, State.MaxTemperature);
+	TemperatureStore.SetTransient(Index, State.HeatingTimeConstant, State.CoolingTimeConstant, State.bCoolToAmbient);
+	TemperatureStore.SetActive(Index, State.bActive);
+	TemperatureStore.SetConductivity(Index, Component->GetConductivity());
+
+	PlayProfile(Index, State.Profile);
+	UpdateSolar(*Component);
+
+	SpatialHash.Add();
+	if (State.bExchangeHeat && Component->GetOwner()) {
+		SpatialHash.Update(Index, Component->GetOwner()->GetActorLocation());
+	}
+
+	//New components are updated every frame until their significance has been evaluated
+	Significances.Add(EThermalSignificance::EveryFrame);
+	++NumSignificances[static_cast<int32>(EThermalSignificance::EveryFrame)];
+
+	//Components placed with an explicit controller keep it, the rest get the controller of the world
+	Component->SetThermalController(Component->GetThermalController() ? Component->GetThermalController() : GetThermalController());
+
+	SET_DWORD_STAT(STAT_LogiThermalActors, ThermalComponents.Num());
+}
+
+void UThermalWorldSubsystem::UnregisterThermalComponent(UThermalComponent* Component)
+{
+	if (!Component || !ThermalComponents.IsValidIndex(Component->ThermalIndex)) return;
+
+	WaitForSimulation();
+	RemoveThermalComponentAt(Component->ThermalIndex);
+}
+
+void UThermalWorldSubsystem::UpdateTemperatures(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return;
+
+	WaitForSimulation();
+
+	const FThermalState& State = Component.GetThermalState();
+	TemperatureStore.SetTemperatures(Component.ThermalIndex, State.BaseTemperature, State.CurrentTemperature, State.MaxTemperature);
+}
+
+void UThermalWorldSubsystem::UpdateTransient(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return;
+
+	WaitForSimulation();
+
+	const FThermalState& State = Component.GetThermalState();
+	TemperatureStore.SetTransient(Component.ThermalIndex, State.HeatingTimeConstant, State.CoolingTimeConstant, State.bCoolToAmbient);
+	TemperatureStore.SetActive(Component.ThermalIndex, State.bActive);
+
+	if (State.bExchangeHeat && Component.GetOwner()) {
+		SpatialHash.Update(Component.ThermalIndex, Component.GetOwner()->GetActorLocation());
+	}
+	else {
+		SpatialHash.Remove(Component.ThermalIndex);
+	}
+}
+
+void UThermalWorldSubsystem::UpdateSolar(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return;
+
+	WaitForSimulation();
+
+	const AActor* Owner = Component.GetOwner();
+	const float Absorptivity = Component.GetThermalState().Absorptivity;
+
+	TemperatureStore.SetSolar(Component.ThermalIndex, Absorptivity, Owner ? FVector3f(Owner->GetActorUpVector()) : FVector3f::UpVector);
+	bSolarDirty |= Absorptivity > 0.0f;
+
+	//Only movable actors can turn their surface, the rest keep the normal they registered with
+	SetMovableSolar(Component.ThermalIndex, TemperatureStore.IsSolar(Component.ThermalIndex) && Owner && Owner->IsRootComponentMovable());
+}
+
+void UThermalWorldSubsystem::SetMovableSolar(const int32 Index, const bool bMovableSolar)
+{
+	const int32 Slot = MovableSolarSlots[Index];
+
+	if (bMovableSolar && Slot == INDEX_NONE) {
+		MovableSolarSlots[Index] = MovableSolarIndices.Add(Index);
+	}
+	else if (!bMovableSolar && Slot != INDEX_NONE) {
+		//Move the last movable component into the freed slot
+		const int32 LastIndex = MovableSolarIndices.Last();
+		MovableSolarIndices.RemoveAtSwap(Slot, 1, false);
+		if (LastIndex != Index) {
+			MovableSolarSlots[LastIndex] = Slot;
+		}
+		MovableSolarSlots[Index] = INDEX_NONE;
+	}
+}
+
+void UThermalWorldSubsystem::PlayThermalProfile(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return;
+
+	WaitForSimulation();
+
+	PlayProfile(Component.ThermalIndex, Component.GetThermalState().Profile);
+}
+
+void UThermalWorldSubsystem::PlayProfile(const int32 Index, UThermalProfile* Profile)
+{
+	//Profiles created at runtime were never loaded, bake them on first use
+	if (Profile && Profile->GetLUT().Num() != UThermalProfile::LUTSize) {
+		Profile->Bake();
+	}
+
+	TemperatureStore.PlayProfile(Index, Profile);
+}
+
+float UThermalWorldSubsystem::GetCurrentTemperature(const UThermalComponent& Component) const
+{
+	return ThermalComponents.IsValidIndex(Component.ThermalIndex) ? TemperatureStore.GetCurrent(Component.ThermalIndex) : Component.GetThermalState().CurrentTemperature;
+}
+
+float UThermalWorldSubsystem::GetProfileTime(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return -1.0f;
+
+	//The simulation task advances the profile times
+	WaitForSimulation();
+
+	return TemperatureStore.GetProfileTime(Component.ThermalIndex);
+}
+
+void UThermalWorldSubsystem::PrioritizeThermalComponent(const UThermalComponent& Component)
+{
+	if (!ThermalComponents.IsValidIndex(Component.ThermalIndex)) return;
+
+	WaitForSimulation();
+
+	TemperatureStore.MarkPriority(Component.ThermalIndex);
+}
+
+void UThermalWorldSubsystem::StampAmbientTemperature(const FVector& Location, const float Radius, const float TemperatureOffset)
+{
+	//The running steps sample the volume
+	WaitForSimulation();
+
+	if (AmbientVolume.IsEmpty()) {
+		AmbientVolume.SetVoxelSize(CVarThermalAmbientVoxelSize.GetValueOnGameThread());
+	}
+
+	AmbientVolume.Stamp(Location, Radius, TemperatureOffset);
+	bAmbientVolumeChanged = true;
+}
+
+void UThermalWorldSubsystem::ClearAmbientTemperature()
+{
+	WaitForSimulation();
+
+	AmbientVolume.Reset();
+	bAmbientVolumeChanged = true;
+}
+
+float UThermalWorldSubsystem::GetAmbientTemperature(const FVector& Location) const
+{
+	const AThermalController* Controller = GetThermalController();
+	return (Controller ? Controller->GetBackgroundTemperature() : 0.0f) + AmbientVolume.Sample(FVector3f(Location));
+}
+
+void UThermalWorldSubsystem::SaveThermalSnapshot(TArray<uint8>& OutData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSnapshotSave);
+
+	WaitForSimulation();
+
+	const int32 NumEntries = TemperatureStore.Num();
+	const TConstArrayView<float> BaseTemperatures = TemperatureStore.GetBaseTemperatures();
+	const TConstArrayView<float> CurrentTemperatures = TemperatureStore.GetCurrentTemperatures();
+	const TConstArrayView<float> MaxTemperatures = TemperatureStore.GetMaxTemperatures();
+
+	//One range for the whole snapshot, so every entry is quantized with the same step
+	float RangeMin = NumEntries > 0 ? BaseTemperatures[0] : 0.0f;
+	float RangeMax = RangeMin;
+	for (int32 Index = 0; Index < NumEntries; ++Index) {
+		RangeMin = FMath::Min3(RangeMin, FMath::Min(BaseTemperatures[Index], CurrentTemperatures[Index]), MaxTemperatures[Index]);
+		RangeMax = FMath::Max3(RangeMax, FMath::Max(BaseTemperatures[Index], CurrentTemperatures[Index]), MaxTemperatures[Index]);
+	}
+
+	TArray<FGuid> Guids;
+	TArray<uint8> Flags;
+	TArray<float> ProfileTimes;
+	Guids.SetNumUninitialized(NumEntries);
+	Flags.SetNumUninitialized(NumEntries);
+	ProfileTimes.SetNumUninitialized(NumEntries);
+
+	for (int32 Index = 0; Index < NumEntries; ++Index) {
+		const UThermalComponent* Component = ThermalComponents[Index];
+		Guids[Index] = Component ? Component->GetThermalGuid() : FGuid();
+		Flags[Index] = TemperatureStore.IsActive(Index) ? ThermalSnapshotActive : 0;
+		ProfileTimes[Index] = TemperatureStore.GetProfileTime(Index);
+	}
+
+	TArray<float> Scratch;
+	TArray<uint16> QuantizedBase;
+	TArray<uint16> QuantizedCurrent;
+	TArray<uint16> QuantizedMax;
+	QuantizeTemperatures(BaseTemperatures, RangeMin, RangeMax, Scratch, QuantizedBase);
+	QuantizeTemperatures(CurrentTemperatures, RangeMin, RangeMax, Scratch, QuantizedCurrent);
+	QuantizeTemperatures(MaxTemperatures, RangeMin, RangeMax, Scratch, QuantizedMax);
+
+	OutData.Reset();
+	FMemoryWriter Writer(OutData, true);
+
+	uint32 Magic = ThermalSnapshotMagic;
+	int32 Version = static_cast<int32>(EThermalSnapshotVersion::Latest);
+	int32 NumSavedEntries = NumEntries;
+	Writer << Magic << Version << NumSavedEntries << SimulatedSteps << TransientTimeAccumulator << RangeMin << RangeMax;
+
+	//Every array is written as one block
+	Guids.BulkSerialize(Writer);
+	QuantizedBase.BulkSerialize(Writer);
+	QuantizedCurrent.BulkSerialize(Writer);
+	QuantizedMax.BulkSerialize(Writer);
+	Flags.BulkSerialize(Writer);
+	ProfileTimes.BulkSerialize(Writer);
+}
+
+bool UThermalWorldSubsystem::RestoreThermalSnapshot(const TArray<uint8>& Data)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSnapshotRestore);
+
+	FMemoryReader Reader(Data, true);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumEntries = 0;
+	int64 SavedSteps = 0;
+	float SavedTimeAccumulator = 0.0f;
+	float RangeMin = 0.0f;
+	float RangeMax = 0.0f;
+	Reader << Magic << Version << NumEntries << SavedSteps << SavedTimeAccumulator << RangeMin << RangeMax;
+
+	if (Reader.IsError() || Magic != ThermalSnapshotMagic) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to restore the thermal snapshot, the data is not a thermal snapshot"));
+		return false;
+	}
+
+	if (Version < static_cast<int32>(EThermalSnapshotVersion::Initial) || Version > static_cast<int32>(EThermalSnapshotVersion::Latest)) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to restore the thermal snapshot, version %d is not supported"), Version);
+		return false;
+	}
+
+	//The count comes from the data, it can not claim more entries than the rest of the data holds
+	if (NumEntries < 0 || NumEntries > (Reader.TotalSize() - Reader.Tell()) / ThermalSnapshotEntrySize) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to restore the thermal snapshot, %d entries do not fit in %d bytes"), NumEntries, Data.Num());
+		return false;
+	}
+
+	TArray<FGuid> Guids;
+	TArray<uint16> QuantizedBase;
+	TArray<uint16> QuantizedCurrent;
+	TArray<uint16> QuantizedMax;
+	TArray<uint8> Flags;
+	TArray<float> ProfileTimes;
+
+	if (!ReadSnapshotArray(Reader, NumEntries, Guids) || !ReadSnapshotArray(Reader, NumEntries, QuantizedBase) || !ReadSnapshotArray(Reader, NumEntries, QuantizedCurrent)
+		|| !ReadSnapshotArray(Reader, NumEntries, QuantizedMax) || !ReadSnapshotArray(Reader, NumEntries, Flags) || !ReadSnapshotArray(Reader, NumEntries, ProfileTimes)) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to restore the thermal snapshot, the data is truncated"));
+		return false;
+	}
+
+	WaitForSimulation();
+
+	TMap<FGuid, int32> ComponentIndices;
+	ComponentIndices.Reserve(ThermalComponents.Num());
+	for (int32 Index = 0; Index < ThermalComponents.Num(); ++Index) {
+		if (const UThermalComponent* Component = ThermalComponents[Index]) {
+			ComponentIndices.Add(Component->GetThermalGuid(), Index);
+		}
+	}
+
+	int32 NumMissing = 0;
+
+	for (int32 Entry = 0; Entry < NumEntries; ++Entry) {
+		const int32* Index = ComponentIndices.Find(Guids[Entry]);
+		if (!Index) {
+			++NumMissing;
+			continue;
+		}
+
+		//The component keeps the restored state as well, it is registered again with it after unregistering
+		FThermalState& State = ThermalComponents[*Index]->ThermalState;
+		State.BaseTemperature = DequantizeTemperature(QuantizedBase[Entry], RangeMin, RangeMax);
+		State.CurrentTemperature = DequantizeTemperature(QuantizedCurrent[Entry], RangeMin, RangeMax);
+		State.MaxTemperature = DequantizeTemperature(QuantizedMax[Entry], RangeMin, RangeMax);
+		State.bActive = (Flags[Entry] & ThermalSnapshotActive) != 0;
+
+		TemperatureStore.SetTemperatures(*Index, State.BaseTemperature, State.CurrentTemperature, State.MaxTemperature);
+		TemperatureStore.SetActive(*Index, State.bActive);
+
+		//Profiles continue from the saved time, components without their profile keep the restored temperature
+		if (ProfileTimes[Entry] >= 0.0f && State.Profile) {
+			PlayProfile(*Index, State.Profile);
+			TemperatureStore.SetProfileTime(*Index, ProfileTimes[Entry]);
+		}
+		else {
+			TemperatureStore.PlayProfile(*Index, nullptr);
+		}
+	}
+
+	SimulatedSteps = SavedSteps;
+	TransientTimeAccumulator = SavedTimeAccumulator;
+
+	if (NumMissing > 0) {
+		UE_LOG(LogTemp, Warning, TEXT("Restored the thermal snapshot without %d of its %d entries, no registered component has their thermal GUID"), NumMissing, NumEntries);
+	}
+
+	return true;
+}
+
+void UThermalWorldSubsystem::RegisterThermalController(AThermalController* Controller)
+{
+	if (!Controller || ThermalControllers.Contains(Controller)) return;
+
+	ThermalControllers.Add(Controller);
+
+	//Notify the components that began play before the controller spawned
+	for (UThermalComponent* Component : ThermalComponents) {
+		if (Component && !Component->GetThermalController()) {
+			Component->SetThermalController(Controller);
+		}
+	}
+}
+
+void UThermalWorldSubsystem::UnregisterThermalController(AThermalController* Controller)
+{
+	if (!Controller || ThermalControllers.Remove(Controller) == 0) return;
+
+	//Hand the components of the removed controller over to the next one, or restore their original materials
+	AThermalController* NextController = GetThermalController();
+
+	for (UThermalComponent* Component : ThermalComponents) {
+		if (Component && Component->GetThermalController() == Controller) {
+			Component->SetThermalController(NextController);
+		}
+	}
+}
+
+UMaterialInterface* UThermalWorldSubsystem::GetSkeletalSectionMaterial(const int32 MaterialSlot)
+{
+	if (SkeletalSectionMaterials.Num() == 0) {
+		UMaterialInterface* Parent = GetDefault<ULogiSettings>()->SkeletalThermalMaterial.LoadSynchronous();
+		if (!Parent) return nullptr;
+
+		for (int32 Section = 0; Section < ThermalPrimitiveData::MaxSections; ++Section) {
+			UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(Parent, this);
+
+			FLinearColor MaskA(ForceInitToZero);
+			FLinearColor MaskB(ForceInitToZero);
+			(Section < 4 ? MaskA : MaskB).Component(Section % 4) = 1.0f;
+
+			Material->SetVectorParameterValue(SectionMaskAParameterName, MaskA);
+			Material->SetVectorParameterValue(SectionMaskBParameterName, MaskB);
+			SkeletalSectionMaterials.Add(Material);
+		}
+	}
+
+	return SkeletalSectionMaterials[FMath::Clamp(MaterialSlot, 0, ThermalPrimitiveData::MaxSections - 1)];
+}
+
+AThermalController* UThermalWorldSubsystem::GetThermalController() const
+{
+	return ThermalControllers.Num() > 0 ? ThermalControllers[0].Get() : nullptr;
+}
+
+bool UThermalWorldSubsystem::UpdateThermalImage(const FThermalImageSettings& Settings)
+{
+	if (!ThermalImageExtension.IsValid()) return false;
+
+	FThermalImageSettings ExtensionSettings = Settings;
+	ExtensionSettings.BlueNoiseTexture = BlueNoiseTexture;
+
+	ThermalImageExtension->SetSettings(ExtensionSettings);
+	return true;
+}
+
+void UThermalWorldSubsystem::RemoveThermalComponentAt(const int32 Index)
+{
+	if (UThermalComponent* Component = ThermalComponents[Index]) {
+		Component->ThermalIndex = INDEX_NONE;
+	}
+
+	SetMovableSolar(Index, false);
+
+	ThermalComponents.RemoveAtSwap(Index, 1, false);
+	TemperatureStore.RemoveAtSwap(Index);
+	SpatialHash.RemoveAtSwap(Index);
+	MovableSolarSlots.RemoveAtSwap(Index, 1, false);
+
+	//The component moved into the removed slot keeps its place in the movable sunlit list under its new index
+	if (MovableSolarSlots.IsValidIndex(Index) && MovableSolarSlots[Index] != INDEX_NONE) {
+		MovableSolarIndices[MovableSolarSlots[Index]] = Index;
+	}
+
+	--NumSignificances[static_cast<int32>(Significances[Index])];
+	Significances.RemoveAtSwap(Index, 1, false);
+
+	//Fix up the index of the component that was moved into the removed slot
+	if (ThermalComponents.IsValidIndex(Index) && ThermalComponents[Index]) {
+		ThermalComponents[Index]->ThermalIndex = Index;
+	}
+
+	SET_DWORD_STAT(STAT_LogiThermalActors, ThermalComponents.Num());
+}
+
+void UThermalWorldSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//The steps launched last frame ran alongside this frame of the game thread, their temperatures are sent now
+	WaitForSimulation();
+
+	const AThermalController* Controller = GetThermalController();
+	if (!Controller) return;
+
+	if (TemperatureStore.SetRange(Controller->GetThermalCameraRangeMin(), Controller->GetThermalCameraRangeMax())) {
+		//Per instance temperatures live on the components, they are normalized again when the range changes
+		for (UThermalComponent* Component : ThermalComponents) {
+			if (IsValid(Component) && Component->HasThermalInstances()) {
+				Component->RefreshInstanceTemperatures();
+			}
+		}
+	}
+	UpdateSolarHeating(*Controller);
+	TemperatureStore.Normalize();
+	UpdateThermalComponents(Controller);
+
+	//Launched last, the store belongs to the task until the next wait
+	SimulateTransient(DeltaTime, *Controller);
+}
+
+void UThermalWorldSubsystem::UpdateThermalComponents(const AThermalController* Controller)
+{
+	const bool bUseSignificance = ThermalSignificance::IsEnabled();
+
+	//Nothing freezes without significance, the entries frozen before it was turned off are sent again
+	if (!bUseSignificance && TemperatureStore.GetNumFrozen() > 0) {
+		TemperatureStore.ThawAll();
+	}
+
+	//Nothing changed since the GPU got the last temperatures. Frozen entries are not pending, but their significance is still evaluated so they can thaw.
+	if (TemperatureStore.GetNumPending() == 0 && TemperatureStore.GetNumFrozen() == 0) {
+		SET_DWORD_STAT(STAT_LogiThermalUpdateBacklog, 0);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalActorUpdate);
+
+	if (bUseSignificance) {
+		UpdateSignificance();
+	}
+
+	const double BudgetSeconds = FMath::Max(CVarThermalUpdateBudgetUs.GetValueOnGameThread(), 0.0f) / 1000000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<int32, TInlineAllocator<8>> InvalidIndices;
+	int32 NumUpdated = 0;
+
+	//Sends one entry, returns false once the frame budget is used up
+	const auto UpdateEntry = [&](const int32 Index)
+	{
+		//Far away and small components wait for their frame. Frozen ones leave the scan until UpdateSignificance thaws them.
+		if (bUseSignificance && !ThermalSignificance::ShouldUpdate(Significances[Index], Index, GFrameCounter)) {
+			if (Significances[Index] == EThermalSignificance::Frozen) {
+				TemperatureStore.Freeze(Index);
+			}
+			return true;
+		}
+
+		UThermalComponent* Component = ThermalComponents[Index];
+
+		//Drop components that were destroyed without ending play, after the pass so the indices stay stable
+		if (!IsValid(Component)) {
+			InvalidIndices.Add(Index);
+		}
+		else {
+			UpdateThermalComponent(*Component, Controller);
+			++NumUpdated;
+		}
+
+		TemperatureStore.ClearDirty(Index);
+
+		return BudgetSeconds <= 0.0 || FPlatformTime::Seconds() - StartTime < BudgetSeconds;
+	};
+
+	bool bWithinBudget = true;
+
+	//Components whose temperature changed (gameplay, simulation, profiles, heat exchange, sun) or that just began play go first
+	for (int32 Index = TemperatureStore.FindNextPriority(0); bWithinBudget && Index != INDEX_NONE; Index = TemperatureStore.FindNextPriority(Index + 1)) {
+		bWithinBudget = UpdateEntry(Index);
+	}
+
+	//The rest only changed with the camera range, continue where the last frame stopped and go around at most once
+	if (bWithinBudget && TemperatureStore.GetNumPending() > 0) {
+		const int32 StartIndex = FMath::Min(UpdateCursor, TemperatureStore.Num());
+		bool bWrapped = false;
+
+		for (int32 Index = TemperatureStore.FindNextDirty(StartIndex); bWithinBudget; Index = TemperatureStore.FindNextDirty(Index + 1)) {
+			if (Index == INDEX_NONE && !bWrapped) {
+				bWrapped = true;
+				Index = TemperatureStore.FindNextDirty(0);
+			}
+
+			if (Index == INDEX_NONE || (bWrapped && Index >= StartIndex)) break;
+
+			bWithinBudget = UpdateEntry(Index);
+			UpdateCursor = Index + 1;
+		}
+	}
+
+	//Remove from the back so the swapped in entries are not invalidated
+	InvalidIndices.Sort(TGreater<int32>());
+	for (const int32 Index : InvalidIndices) {
+		RemoveThermalComponentAt(Index);
+	}
+
+	INC_DWORD_STAT_BY(STAT_LogiThermalActorsUpdated, NumUpdated);
+	SET_DWORD_STAT(STAT_LogiThermalUpdateBacklog, TemperatureStore.GetNumPending());
+}
+
+void UThermalWorldSubsystem::SimulateTransient(const float DeltaTime, const AThermalController& Controller)
+{
+	const bool bExchangeHeat = CVarThermalHeatExchangeEnabled.GetValueOnGameThread() && SpatialHash.NumHashed() > 0;
+
+	if (!TemperatureStore.HasTransientEntries() && !TemperatureStore.HasPlayingProfiles() && !bExchangeHeat) {
+		TransientTimeAccumulator = 0.0f;
+		return;
+	}
+
+	FThermalSimulationSettings Settings;
+	Settings.StepSeconds = 1.0f / FMath::Max(CVarThermalTransientHz.GetValueOnGameThread(), 1.0f);
+	const int32 MaxSteps = FMath::Max(CVarThermalTransientMaxSteps.GetValueOnGameThread(), 1);
+
+	TransientTimeAccumulator += DeltaTime;
+	Settings.NumSteps = FMath::Min(FMath::FloorToInt32(TransientTimeAccumulator / Settings.StepSeconds), MaxSteps);
+	TransientTimeAccumulator = FMath::Min(TransientTimeAccumulator - Settings.NumSteps * Settings.StepSeconds, Settings.StepSeconds);
+
+	if (Settings.NumSteps == 0) return;
+
+	Settings.AmbientTemperature = Controller.GetBackgroundTemperature();
+	Settings.bExchangeHeat = bExchangeHeat;
+
+	//The actors are moved on the game thread, the task only reads the hash
+	if (bExchangeHeat) {
+		Settings.HeatExchangeRadius = FMath::Max(CVarThermalHeatExchangeRadius.GetValueOnGameThread(), 1.0f);
+		Settings.HeatExchangeCoefficient = CVarThermalHeatExchangeCoefficient.GetValueOnGameThread();
+		Settings.HeatExchangeMaxNeighbours = FMath::Clamp(CVarThermalHeatExchangeMaxNeighbours.GetValueOnGameThread(), 0, 64);
+
+		SpatialHash.SetCellSize(Settings.HeatExchangeRadius);
+		UpdateSpatialHash();
+	}
+
+	//The task samples the volume, the game thread only gathers the locations. An empty volume is sampled once more after it was cleared.
+	Settings.bSampleAmbient = !AmbientVolume.IsEmpty() || bAmbientVolumeChanged;
+	if (Settings.bSampleAmbient) {
+		GatherAmbientLocations();
+		bAmbientVolumeChanged = false;
+	}
+
+	if (!CVarThermalTransientAsync.GetValueOnGameThread()) {
+		SimulatedSteps += Settings.NumSteps;
+		RunSimulation(TemperatureStore, SpatialHash, AmbientVolume, AmbientLocations, Settings);
+		TemperatureStore.Publish();
+		return;
+	}
+
+	SimulatedSteps += Settings.NumSteps;
+
+	SimulationTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this, Settings]() {
+		RunSimulation(TemperatureStore, SpatialHash, AmbientVolume, AmbientLocations, Settings);
+	}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadHiPriTask);
+}
+
+void UThermalWorldSubsystem::GatherAmbientLocations()
+{
+	AmbientLocations.SetNumUninitialized(ThermalComponents.Num());
+
+	for (int32 Index = 0; Index < ThermalComponents.Num(); ++Index) {
+		if (!TemperatureStore.IsCoolToAmbient(Index)) continue;
+
+		const UThermalComponent* Component = ThermalComponents[Index];
+		const AActor* Owner = IsValid(Component) ? Component->GetOwner() : nullptr;
+		AmbientLocations[Index] = Owner ? FVector3f(Owner->GetActorLocation()) : FVector3f::ZeroVector;
+	}
+}
+
+void UThermalWorldSubsystem::WaitForSimulation()
+{
+	if (!SimulationTask.IsValid()) return;
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_LogiThermalSimulationWait);
+
+		//Only the local queue is processed, so nothing can call back into the subsystem while it waits
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(SimulationTask, ENamedThreads::GameThread_Local);
+	}
+
+	SimulationTask = nullptr;
+	TemperatureStore.Publish();
+}
+
+void UThermalWorldSubsystem::WaitForSimulationInAllWorlds()
+{
+	if (!GEngine) return;
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts()) {
+		const UWorld* World = WorldContext.World();
+
+		if (UThermalWorldSubsystem* Subsystem = World ? World->GetSubsystem<UThermalWorldSubsystem>() : nullptr) {
+			Subsystem->WaitForSimulation();
+		}
+	}
+}
+
+void UThermalWorldSubsystem::RefreshProfileInAllWorlds(const UThermalProfile& Profile)
+{
+	if (!GEngine) return;
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts()) {
+		const UWorld* World = WorldContext.World();
+
+		if (UThermalWorldSubsystem* Subsystem = World ? World->GetSubsystem<UThermalWorldSubsystem>() : nullptr) {
+			Subsystem->WaitForSimulation();
+			Subsystem->TemperatureStore.RefreshProfile(&Profile);
+		}
+	}
+}
+
+void UThermalWorldSubsystem::UpdateSolarHeating(const AThermalController& Controller)
+{
+	if (!TemperatureStore.HasSolarEntries()) return;
+
+	FVector3f DirectionToSun;
+	float Intensity = 0.0f;
+	Controller.GetSunHeating(DirectionToSun, Intensity);
+
+	const float MinCos = FMath::Cos(FMath::DegreesToRadians(FMath::Max(CVarThermalSolarMinSunAngle.GetValueOnGameThread(), 0.0f)));
+
+	//Vehicles, doors and other movable actors turn their surface toward or away from the sun, by the same angle the sun has to move
+	TurnedSolarIndices.Reset();
+	for (const int32 Index : MovableSolarIndices) {
+		const UThermalComponent* Component = ThermalComponents[Index];
+		const AActor* Owner = IsValid(Component) ? Component->GetOwner() : nullptr;
+
+		if (Owner && TemperatureStore.SetSolarNormal(Index, FVector3f(Owner->GetActorUpVector()), MinCos)) {
+			TurnedSolarIndices.Add(Index);
+		}
+	}
+
+	//The pass touches every thermal actor, it only runs when the sun has visibly moved or sunlit components were added.
+	//Actors that only turned are heated by the sun of the last pass, so they match the rest of the world.
+	const bool bSunMoved = (DirectionToSun | SolarDirection) < MinCos || !FMath::IsNearlyEqual(Intensity, SolarIntensity, 0.01f);
+
+	if (!bSunMoved && !bSolarDirty) {
+		if (TurnedSolarIndices.Num() > 0) {
+			TemperatureStore.ApplySolarHeating(TurnedSolarIndices, SolarDirection, SolarIntensity);
+		}
+		return;
+	}
+
+	TemperatureStore.ApplySolarHeating(DirectionToSun, Intensity);
+
+	SolarDirection = DirectionToSun;
+	SolarIntensity = Intensity;
+	bSolarDirty = false;
+}
+
+void UThermalWorldSubsystem::UpdateSpatialHash()
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSpatialHash);
+
+	for (int32 Index = SpatialHash.FindNext(0); Index != INDEX_NONE; Index = SpatialHash.FindNext(Index + 1)) {
+		const UThermalComponent* Component = ThermalComponents[Index];
+		const AActor* Owner = IsValid(Component) ? Component->GetOwner() : nullptr;
+
+		//Destroyed components are removed by the update pass, until then they stay where they were
+		if (Owner) {
+			SpatialHash.Update(Index, Owner->GetActorLocation());
+		}
+	}
+}
+
+void UThermalWorldSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_LogiThermalSignificance);
+
+	const UWorld* World = GetWorld();
+	const int32 NumComponents = ThermalComponents.Num();
+	if (!World || NumComponents == 0) return;
+
+	const TConstArrayView<FVector> ViewLocations = World->ViewLocationsRenderedLastFrame;
+	const int32 NumEvaluations = FMath::Min(ThermalSignificance::GetEvaluationsPerFrame(), NumComponents);
+
+	for (int32 Evaluation = 0; Evaluation < NumEvaluations; ++Evaluation) {
+		const int32 Index = SignificanceCursor++ % NumComponents;
+		const UThermalComponent* Component = ThermalComponents[Index];
+		if (!Component) continue;
+
+		const EThermalSignificance OldSignificance = Significances[Index];
+		const EThermalSignificance NewSignificance = ThermalSignificance::Evaluate(*Component, ViewLocations);
+		if (OldSignificance == NewSignificance) continue;
+
+		Significances[Index] = NewSignificance;
+		--NumSignificances[static_cast<int32>(OldSignificance)];
+		++NumSignificances[static_cast<int32>(NewSignificance)];
+
+		//Components that just became visible go to the front if their temperatures are out of date
+		if (OldSignificance == EThermalSignificance::Frozen) {
+			TemperatureStore.Thaw(Index);
+		}
+	}
+
+	SignificanceCursor %= NumComponents;
+
+	SET_DWORD_STAT(STAT_LogiThermalFrozen, NumSignificances[static_cast<int32>(EThermalSignificance::Frozen)]);
+}
+
+void UThermalWorldSubsystem::UpdateThermalComponent(UThermalComponent& Component, const AThermalController* WorldController)
+{
+	const AThermalController* Controller = Component.GetThermalController();
+	if (!Controller) return;
+
+	const int32 Index = Component.ThermalIndex;
+	float BaseTemperature = TemperatureStore.GetNormalizedBase(Index);
+	float CurrentTemperature = TemperatureStore.GetNormalizedCurrent(Index);
+	float MaxTemperature = TemperatureStore.GetNormalizedMax(Index);
+
+	//The store is normalized to the range of the world controller, components with their own controller use its range
+	if (Controller != WorldController) {
+		const FThermalState& State = Component.GetThermalState();
+		BaseTemperature = UKismetMathLibrary::NormalizeToRange(State.BaseTemperature, Controller->GetThermalCameraRangeMin(), Controller->GetThermalCameraRangeMax());
+		CurrentTemperature = UKismetMathLibrary::NormalizeToRange(TemperatureStore.GetSurfaceCurrent(Component.ThermalIndex), Controller->GetThermalCameraRangeMin(), Controller->GetThermalCameraRangeMax());
+		MaxTemperature = UKismetMathLibrary::NormalizeToRange(State.MaxTemperature, Controller->GetThermalCameraRangeMin(), Controller->GetThermalCameraRangeMax());
+	}
+
+	//Skeletal meshes read custom primitive data in either mode
+	if (Component.GetThermalSections().Num() > 0) {
+		UpdateSkeletalSections(Component, *Controller, FVector(BaseTemperature, CurrentTemperature, MaxTemperature));
+	}
+
+	if (Component.UsesCustomPrimitiveData()) {
+		UpdateCustomPrimitiveData(Component, FVector(BaseTemperature, CurrentTemperature, MaxTemperature));
+		return;
+	}
+
+	//Push the temperatures to the actors own material instance, it keeps them while the original materials are shown
+	if (UMaterialInstanceDynamic* DynamicMaterialInstance = Component.GetDynamicMaterialInstance()) {
+		DynamicMaterialInstance->SetScalarParameterValue(CurrentTemperatureParameterName, CurrentTemperature);
+		DynamicMaterialInstance->SetScalarParameterValue(MaxTemperatureParameterName, MaxTemperature);
+		DynamicMaterialInstance->SetScalarParameterValue(BaseTemperatureParameterName, BaseTemperature);
+	}
+}
+
+void UThermalWorldSubsystem::UpdateCustomPrimitiveData(const UThermalComponent& Component, const FVector& Temperatures)
+{
+	static_assert(ThermalPrimitiveData::CurrentTemperature == ThermalPrimitiveData::BaseTemperature + 1 && ThermalPrimitiveData::MaxTemperature == ThermalPrimitiveData::BaseTemperature + 2,
+		"The thermal primitive data slots are written as one vector");
+
+	for (const FThermalMeshMaterials& Meshes : Component.GetThermalMeshes()) {
+		UMeshComponent* MeshComponent = Meshes.Mesh.Get();
+
+		//Instanced meshes read their temperatures from the per instance custom data, skeletal meshes are written with their sections
+		if (!MeshComponent || Meshes.bInstanced || Meshes.bSkeletal) continue;
+
+		//Every write sends the primitive data to the render thread, skip meshes that already have the temperatures
+		const TArray<float>& Data = MeshComponent->GetCustomPrimitiveData().Data;
+		if (Data.Num() > ThermalPrimitiveData::MaxTemperature
+			&& Data[ThermalPrimitiveData::BaseTemperature] == Temperatures.X
+			&& Data[ThermalPrimitiveData::CurrentTemperature] == Temperatures.Y
+			&& Data[ThermalPrimitiveData::MaxTemperature] == Temperatures.Z) {
+			continue;
+		}
+
+		MeshComponent->SetCustomPrimitiveDataVector3(ThermalPrimitiveData::BaseTemperature, Temperatures);
+	}
+}
+
+void UThermalWorldSubsystem::UpdateSkeletalSections(const UThermalComponent& Component, const AThermalController& Controller, const FVector& Temperatures)
+{
+	static_assert(ThermalPrimitiveData::SectionTemperatures % 4 == 0 && ThermalPrimitiveData::MaxSections == 8 && ThermalPrimitiveData::Emissivity == 3,
+		"The section temperatures are written as two aligned float4 vectors");
+
+	for (const FThermalSectionTemperatures& Sections : Component.GetThermalSections()) {
+		USkeletalMeshComponent* Mesh = Sections.Mesh.Get();
+		if (!Mesh) continue;
+
+		//Slots without their own temperature show the temperature of the actor
+		float Data[ThermalPrimitiveData::SectionTemperatures + ThermalPrimitiveData::MaxSections];
+		Data[ThermalPrimitiveData::BaseTemperature] = Temperatures.X;
+		Data[ThermalPrimitiveData::CurrentTemperature] = Temperatures.Y;
+		Data[ThermalPrimitiveData::MaxTemperature] = Temperatures.Z;
+		//The emissivity was written when the component registered
+		const TArray<float>& CurrentData = Mesh->GetCustomPrimitiveData().Data;
+		Data[ThermalPrimitiveData::Emissivity] = CurrentData.IsValidIndex(ThermalPrimitiveData::Emissivity) ? CurrentData[ThermalPrimitiveData::Emissivity] : 1.0f;
+
+		for (int32 Section = 0; Section < ThermalPrimitiveData::MaxSections; ++Section) {
+			Data[ThermalPrimitiveData::SectionTemperatures + Section] = (Sections.OverrideMask & (1 << Section))
+				? UKismetMathLibrary::NormalizeToRange(Sections.Temperatures[Section], Controller.GetThermalCameraRangeMin(), Controller.GetThermalCameraRangeMax())
+				: Temperatures.Y;
+		}
+
+		//Every write sends the primitive data to the render thread, skip meshes that already have the temperatures
+		if (CurrentData.Num() >= UE_ARRAY_COUNT(Data) && FMemory::Memcmp(CurrentData.GetData(), Data, sizeof(Data)) == 0) continue;
+
+		for (int32 DataIndex = 0; DataIndex < UE_ARRAY_COUNT(Data); DataIndex += 4) {
+			Mesh->SetCustomPrimitiveDataVector4(DataIndex, FVector4(Data[DataIndex], Data[DataIndex + 1], Data[DataIndex + 2], Data[DataIndex + 3]));
+		}
+	}
+}
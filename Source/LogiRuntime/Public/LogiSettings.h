@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "LogiSettings.generated.h"
+
+class UMaterialInterface;
+class UPhysicalMaterial;
+class UTexture2D;
+
+// How thermal meshes get their temperatures into the thermal material
+UENUM()
+enum class EThermalMaterialMode : uint8
+{
+	// One dynamic material instance per thermal actor, temperatures are material parameters.
+	// Every mesh of the actor shows the thermal material class of its first mesh.
+	DynamicMaterialInstance,
+
+	// Every thermal mesh shares one material, temperatures are read from custom primitive data so draws can be merged
+	CustomPrimitiveData
+};
+
+// How the thermal image is formed from the scene
+UENUM()
+enum class EThermalImageMode : uint8
+{
+	// PP_Logi_ThermalCamera, one post process material
+	PostProcessMaterial,
+
+	// Compute passes of a scene view extension in game worlds. Editor viewports and hardware without SM5 keep the material.
+	SceneViewExtension
+};
+
+// How PP_Logi_ThermalCamera blurs the thermal image by the Blur setting of the thermal controller
+UENUM()
+enum class EThermalBlurMode : uint8
+{
+	// Seven fixed taps inside the thermal camera material, Blur blends towards them
+	Legacy7Tap,
+
+	// Horizontal and vertical Gaussian passes before the thermal camera material, full Blur is a radius of 32 pixels
+	SeparableGaussian
+};
+
+// Custom primitive data slots read by the custom primitive data variant of the thermal material.
+// The instanced variant reads the same slots from per instance custom data.
+namespace ThermalPrimitiveData
+{
+	constexpr int32 BaseTemperature = 0;
+	constexpr int32 CurrentTemperature = 1;
+	constexpr int32 MaxTemperature = 2;
+
+	constexpr int32 NumFloats = 3;
+
+	// Emissivity of the thermal material class of the mesh, written once when the thermal component registers
+	constexpr int32 Emissivity = 3;
+
+	// Skeletal meshes also get one current temperature per material slot, read as two float4 vectors
+	constexpr int32 SectionTemperatures = 4;
+	constexpr int32 MaxSections = 8;
+
+	// Reflectivity of the thermal material class of the mesh, after the section temperatures
+	constexpr int32 Reflectivity = SectionTemperatures + MaxSections;
+}
+
+// How a surface shows up on the thermal camera, looked up by the physical material of a mesh
+USTRUCT()
+struct LOGIRUNTIME_API FThermalMaterialClass
+{
+	GENERATED_BODY()
+
+	// Share of its own temperature a surface shows, the rest is the reflected sky. Skin is close to 1, bare metal close to 0.
+	UPROPERTY(EditAnywhere, Category = "Logi", meta = (ClampMin = "0", ClampMax = "1"))
+	float Emissivity = 1.0f;
+
+	// Strength of the view dependent reflection on top of the emitted temperature
+	UPROPERTY(EditAnywhere, Category = "Logi", meta = (ClampMin = "0", ClampMax = "1"))
+	float Reflectivity = 0.0f;
+
+	// Scales how fast the surface exchanges heat with its neighbours
+	UPROPERTY(EditAnywhere, Category = "Logi", meta = (ClampMin = "0"))
+	float Conductivity = 1.0f;
+};
+
+/**
+ * Project settings of the Logi thermal camera, found under Project Settings > Plugins > Logi.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Logi"))
+class LOGIRUNTIME_API ULogiSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	ULogiSettings();
+
+	virtual FName GetCategoryName() const override;
+
+	bool UseCustomPrimitiveData() const { return ThermalMaterialMode == EThermalMaterialMode::CustomPrimitiveData; }
+
+	// The scene view extension is selected and the RHI can run its compute passes
+	bool UseThermalImageExtension() const;
+
+	// Thermal material that matches the thermal material mode
+	TSoftObjectPtr<UMaterialInterface> GetThermalMaterial() const;
+
+	// Class of the physical material, nullptr when it has none
+	const FThermalMaterialClass* FindThermalMaterialClass(const UPhysicalMaterial* PhysicalMaterial) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material")
+	EThermalMaterialMode ThermalMaterialMode = EThermalMaterialMode::DynamicMaterialInstance;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material")
+	TSoftObjectPtr<UMaterialInterface> ThermalMaterial;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material")
+	TSoftObjectPtr<UMaterialInterface> CustomPrimitiveDataThermalMaterial;
+
+	// Shared by the instanced static meshes of every thermal actor, whatever the thermal material mode
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material")
+	TSoftObjectPtr<UMaterialInterface> InstancedThermalMaterial;
+
+	// Parent of the per material slot materials of skeletal meshes, whatever the thermal material mode
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material")
+	TSoftObjectPtr<UMaterialInterface> SkeletalThermalMaterial;
+
+	// Read when a world begins play
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Camera")
+	EThermalImageMode ThermalImageMode = EThermalImageMode::SceneViewExtension;
+
+	// Read when the thermal camera material is generated, regenerate it after changing this
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Camera")
+	EThermalBlurMode ThermalBlurMode = EThermalBlurMode::SeparableGaussian;
+
+	// Tiling noise of the BlueNoise sensor noise mode. PP_Logi_ThermalCamera references it when generated, the thermal image extension loads it with the world.
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Camera")
+	TSoftObjectPtr<UTexture2D> BlueNoiseTexture;
+
+	// Used by meshes whose physical material has no class below
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material Classes")
+	FThermalMaterialClass DefaultThermalMaterialClass;
+
+	// Resolved once per mesh when a thermal component registers, never per frame
+	UPROPERTY(Config, EditAnywhere, Category = "Thermal Material Classes")
+	TMap<TSoftObjectPtr<UPhysicalMaterial>, FThermalMaterialClass> ThermalMaterialClasses;
+};
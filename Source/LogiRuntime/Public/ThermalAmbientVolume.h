@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ambient air temperature of a world as offsets from the background temperature of the thermal controller,
+ * e.g. warm interiors, cold cellars or exhaust pockets. Stored sparsely in bricks of 8x8x8 voxels that are only
+ * allocated where the offset is not 0, so the memory follows the stamped regions instead of the size of the level.
+ * Every brick also keeps the first voxel layer of its neighbours, so a trilinear sample reads a single brick.
+ */
+struct LOGIRUNTIME_API FThermalAmbientVolume
+{
+	static constexpr int32 BrickShift = 3;
+	static constexpr int32 BrickSize = 1 << BrickShift;
+
+	// Samples per brick axis, the voxels of the brick and the shared layer of the next one
+	static constexpr int32 BrickSamples = BrickSize + 1;
+	static constexpr int32 BrickSampleCount = BrickSamples * BrickSamples * BrickSamples;
+
+	// Changing the voxel size clears the volume
+	void SetVoxelSize(float InVoxelSize);
+	float GetVoxelSize() const { return VoxelSize; }
+
+	// Adds Offset degrees at Center, falling off linearly to 0 at Radius. Bricks that are back at 0 everywhere are freed.
+	void Stamp(const FVector& Center, float Radius, float Offset);
+
+	void Reset();
+
+	bool IsEmpty() const { return BrickIndices.Num() == 0; }
+	int32 NumBricks() const { return BrickIndices.Num(); }
+
+	// Trilinear offset at Location, 0 where no brick is allocated. Thread safe while the volume is not modified.
+	float Sample(const FVector3f& Location) const;
+
+private:
+	float* FindOrAddBrick(const FIntVector& Brick);
+	void FreeBrick(const FIntVector& Brick, int32 BrickIndex);
+
+	float VoxelSize = 100.0f;
+	float InvVoxelSize = 1.0f / 100.0f;
+
+	TMap<FIntVector, int32> BrickIndices;
+
+	// BrickSampleCount offsets per brick, X varies fastest
+	TArray<float> BrickData;
+
+	// Bricks of BrickData that were freed and can be reused
+	TArray<int32> FreeBricks;
+};
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LogiSettings.h"
+#include "ThermalComponent.generated.h"
+
+class AThermalController;
+class UInstancedStaticMeshComponent;
+class USkeletalMeshComponent;
+class UMeshComponent;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UThermalProfile;
+
+// Thermal state of one actor. Replaces the Logi_* variables the patcher used to add to every actor blueprint.
+USTRUCT(BlueprintType)
+struct LOGIRUNTIME_API FThermalState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	float BaseTemperature = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	float MaxTemperature = 25.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	float CurrentTemperature = 10.0f;
+
+	// Seconds to close ~63% of the gap to MaxTemperature while active, 0 leaves CurrentTemperature to gameplay
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi", meta = (ClampMin = "0", Units = "s"))
+	float HeatingTimeConstant = 0.0f;
+
+	// Seconds to close ~63% of the gap to the cooling target while inactive, 0 leaves CurrentTemperature to gameplay
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi", meta = (ClampMin = "0", Units = "s"))
+	float CoolingTimeConstant = 0.0f;
+
+	// Cool down toward the background temperature of the thermal controller instead of BaseTemperature
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	bool bCoolToAmbient = false;
+
+	// Exchanges heat with the nearest thermal actors that have this set as well, e.g. a burning vehicle and the crates around it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	bool bExchangeHeat = false;
+
+	// Heats up toward MaxTemperature while set, e.g. a running engine
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	bool bActive = false;
+
+	// Share of sunlight turned into heat, 0 ignores the sun. The surface faces along the up vector of the actor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi", meta = (ClampMin = "0", ClampMax = "1"))
+	float Absorptivity = 0.0f;
+
+	// Played when the actor begins play, the current temperature follows it until it ends
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	TObjectPtr<UThermalProfile> Profile;
+
+	// Hot actors are written to custom depth so the thermal camera draws them with their own temperature
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	bool bHot = false;
+
+	// 0 = original materials, 1 = thermal material
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Logi")
+	uint8 MaterialIndex = 0;
+};
+
+// Original materials of one mesh component, restored when the thermal camera is turned off
+USTRUCT()
+struct FThermalMeshMaterials
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UMeshComponent> Mesh;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMaterialInterface>> OriginalMaterials;
+
+	// Instanced static meshes use the instanced thermal material and get their temperatures per instance
+	UPROPERTY()
+	bool bInstanced = false;
+
+	// Skeletal meshes use one material per slot and get their temperatures per material slot
+	UPROPERTY()
+	bool bSkeletal = false;
+
+	// Resolved from the physical material of the mesh when it is cached
+	UPROPERTY()
+	FThermalMaterialClass MaterialClass;
+};
+
+// Per material slot temperatures of one skeletal mesh, slots without their own temperature show the actor temperature
+USTRUCT()
+struct FThermalSectionTemperatures
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	float Temperatures[ThermalPrimitiveData::MaxSections] = {};
+
+	// Bit per slot that has its own temperature
+	uint8 OverrideMask = 0;
+};
+
+// Per instance temperatures of one instanced static mesh, interleaved as Base, Current, Max per instance
+USTRUCT()
+struct FThermalInstanceTemperatures
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UInstancedStaticMeshComponent> Mesh;
+
+	TArray<float> Temperatures;
+
+	// Temperatures normalized to the thermal camera range, as written to the per instance custom data
+	TArray<float> NormalizedTemperatures;
+};
+
+/**
+ * Makes its owner a thermal actor. Added to actor blueprints through the SCS by the Logi editor module,
+ * and can be added to any native actor as well. The thermal world subsystem reads the state directly.
+ */
+UCLASS(ClassGroup = (Logi), meta = (BlueprintSpawnableComponent))
+class LOGIRUNTIME_API UThermalComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UThermalComponent();
+
+	// UObject implementation
+	virtual void PostInitProperties() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
+#if WITH_EDITOR
+	virtual void PostEditImport() override;
+#endif
+
+	const FThermalState& GetThermalState() const { return ThermalState; }
+
+	const FGuid& GetThermalGuid() const { return ThermalGuid; }
+
+	// Actors spawned at runtime get a new key every time, set a stable one to restore them from a snapshot of an earlier session
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetThermalGuid(const FGuid& InThermalGuid);
+
+	const TArray<FThermalMeshMaterials>& GetThermalMeshes() const { return ThermalMeshes; }
+
+	UMaterialInstanceDynamic* GetDynamicMaterialInstance() const { return DynamicMaterialInstance; }
+
+	// True when the meshes share the project thermal material and the temperatures are written to custom primitive data
+	bool UsesCustomPrimitiveData() const { return bUsesCustomPrimitiveData; }
+
+	AThermalController* GetThermalController() const { return ThermalController; }
+
+	// Binds to the thermal mode of the new controller and applies it, nullptr restores the original materials
+	void SetThermalController(AThermalController* NewController);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetCurrentTemperature(float Temperature);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetBaseTemperature(float Temperature);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetMaxTemperature(float Temperature);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetHot(bool bInHot);
+
+	// Starts heating up toward the max temperature, or cooling down when cleared
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetThermalActive(bool bInActive);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetExchangeHeat(bool bInExchangeHeat);
+
+	// Also picks up the current orientation of the actor, call it again after rotating a sunlit actor
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetAbsorptivity(float InAbsorptivity);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetTimeConstants(float HeatingTimeConstant, float CoolingTimeConstant, bool bCoolToAmbient);
+
+	// Plays the profile from its start, replacing the heating and cooling of the actor until it ends
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void PlayThermalProfile(UThermalProfile* NewProfile);
+
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void StopThermalProfile();
+
+	// Includes heating and cooling done by the thermal world subsystem since the temperature was last set
+	UFUNCTION(BlueprintPure, Category = "Logi")
+	float GetCurrentTemperature() const;
+
+	// Sets the same temperatures on a range of instances of an instanced static mesh of the owner
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetInstanceTemperatureRange(UInstancedStaticMeshComponent* Mesh, int32 StartInstance, int32 NumInstances, float BaseTemperature, float CurrentTemperature, float MaxTemperature);
+
+	// Sets the current temperature of consecutive instances, starting at StartInstance
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetInstanceCurrentTemperatures(UInstancedStaticMeshComponent* Mesh, int32 StartInstance, const TArray<float>& CurrentTemperatures);
+
+	// Sets the temperatures of consecutive instances, interleaved as Base, Current, Max per instance
+	void SetInstanceTemperatures(UInstancedStaticMeshComponent* Mesh, int32 StartInstance, TConstArrayView<float> InterleavedTemperatures);
+
+	bool HasThermalInstances() const { return ThermalInstances.Num() > 0; }
+
+	// Sets the temperature of one material slot of a skeletal mesh of the owner, e.g. a hot weapon or a warm face.
+	// Slots past the first eight share the temperature of the eighth.
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetSectionTemperature(USkeletalMeshComponent* Mesh, int32 MaterialSlot, float Temperature);
+
+	// Sets the temperature of every material slot whose sections are skinned to the bone
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void SetBoneTemperature(USkeletalMeshComponent* Mesh, FName BoneName, float Temperature);
+
+	// Slots go back to the temperature of the actor
+	UFUNCTION(BlueprintCallable, Category = "Logi")
+	void ClearSectionTemperatures(USkeletalMeshComponent* Mesh);
+
+	const TArray<FThermalSectionTemperatures>& GetThermalSections() const { return ThermalSections; }
+
+	// Mean conductivity of the thermal material classes of the meshes
+	float GetConductivity() const { return Conductivity; }
+
+	// Normalizes every instance temperature to the camera range of the controller and writes it to the instances
+	void RefreshInstanceTemperatures();
+
+	// Swaps every mesh to the thermal material or back to its original materials, does nothing when the mode is unchanged
+	void ApplyThermalMode(bool bThermalCameraActive);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION()
+	void HandleThermalModeChanged(bool bThermalCameraActive);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi", meta = (ShowOnlyInnerProperties))
+	FThermalState ThermalState;
+
+	// Controller the thermal camera range and state is read from. Assigned by the thermal world subsystem when not set.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	TObjectPtr<AThermalController> ThermalController;
+
+	// Key of the component in thermal snapshots, generated when the component is created and saved with the level
+	UPROPERTY(VisibleAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = "Logi")
+	FGuid ThermalGuid;
+
+private:
+	void CacheThermalMeshes();
+	void UpdateRenderCustomDepth() const;
+
+	// Sends the temperatures to the thermal world subsystem once registered
+	void UpdateTemperatures();
+
+	// Sends the heating and cooling settings to the thermal world subsystem once registered
+	void UpdateTransient() const;
+
+	FThermalInstanceTemperatures* FindThermalInstances(const UInstancedStaticMeshComponent* Mesh);
+
+	// Grows the temperature arrays to the instance count of the mesh, new instances get the temperatures of the actor
+	void SyncInstanceCount(FThermalInstanceTemperatures& Instances) const;
+
+	void WriteInstanceTemperatures(FThermalInstanceTemperatures& Instances, int32 StartInstance, int32 NumInstances) const;
+
+	FThermalSectionTemperatures* FindThermalSections(const USkeletalMeshComponent* Mesh);
+
+	// Queues the section temperatures for the next update of the thermal world subsystem
+	void PrioritizeUpdate() const;
+
+	// Writes the emissivity and reflectivity of every mesh to its custom primitive data, or to the dynamic material instance
+	void ApplyThermalMaterialClasses() const;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> DynamicMaterialInstance;
+
+	// Material shown while the thermal camera is on, the dynamic material instance or the shared custom primitive data material
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInterface> ThermalMaterial;
+
+	bool bUsesCustomPrimitiveData = false;
+
+	// Shared material of the instanced static meshes
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInterface> InstancedThermalMaterial;
+
+	UPROPERTY(Transient)
+	TArray<FThermalInstanceTemperatures> ThermalInstances;
+
+	UPROPERTY(Transient)
+	TArray<FThermalSectionTemperatures> ThermalSections;
+
+	float Conductivity = 1.0f;
+
+	UPROPERTY(Transient)
+	TArray<FThermalMeshMaterials> ThermalMeshes;
+
+	// Index in the thermal world subsystem, INDEX_NONE while not registered
+	int32 ThermalIndex = INDEX_NONE;
+
+	friend class UThermalWorldSubsystem;
+};
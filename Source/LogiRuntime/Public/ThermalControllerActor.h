@@ -0,0 +1,229 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ThermalControllerActor.generated.h"
+
+class UMaterialParameterCollection;
+struct FThermalImageSettings;
+
+// MPC_Logi_ThermalSettings parameters that have to be written on the next update
+enum class EThermalSettingsDirty : uint16
+{
+	None					= 0,
+	ThermalCameraToggle		= 1 << 0,
+	BackgroundTemperature	= 1 << 1,
+	SkyTemperature			= 1 << 2,
+	Blur					= 1 << 3,
+	NoiseAmount				= 1 << 4,
+	Cold					= 1 << 5,
+	Mid						= 1 << 6,
+	Hot						= 1 << 7,
+	NoiseSize				= 1 << 8,
+	SensorResolution		= 1 << 9,
+	Palette					= 1 << 10,
+	NoiseMode				= 1 << 11,
+
+	All						= (1 << 12) - 1
+};
+ENUM_CLASS_FLAGS(EThermalSettingsDirty);
+
+// Palette of the thermal image. Custom blends Cold, Mid and Hot, the others are rows of the ThermalPalettes lookup.
+UENUM(BlueprintType)
+enum class EThermalPalette : uint8
+{
+	Custom,
+	Iron,
+	Rainbow,
+	WhiteHot,
+	BlackHot
+};
+
+// Sensor noise of the thermal image, a new pattern 60 times a second in both modes
+UENUM(BlueprintType)
+enum class EThermalNoiseMode : uint8
+{
+	// White noise from an integer hash of the noise cell and frame
+	Hash,
+
+	// ULogiSettings::BlueNoiseTexture tiled over the noise cells, shifted by a hash of the frame
+	BlueNoise
+};
+
+// Filter of the upscale from the sensor resolution to the viewport
+UENUM(BlueprintType)
+enum class EThermalSensorUpscale : uint8
+{
+	Nearest,
+	Bilinear
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnThermalModeChanged, bool, bThermalCameraActive);
+
+/**
+ * Native parent of BP_Logi_ThermalController. Keeps the thermal camera settings and writes them to
+ * MPC_Logi_ThermalSettings in one batch, only on frames where a setting has changed. In game worlds that form the thermal
+ * image with the scene view extension the batch also goes to the extension, and the material is kept switched off.
+ * The properties keep the names of the old blueprint variables so placed controllers keep their values.
+ */
+UCLASS(Blueprintable)
+class LOGIRUNTIME_API AThermalController : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AThermalController();
+
+	virtual void Tick(float DeltaSeconds) override;
+	virtual bool ShouldTickIfViewportsOnly() const override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	bool IsThermalCameraActive() const { return ThermalCameraActive; }
+	float GetThermalCameraRangeMin() const { return ThermalCameraRangeMin; }
+	float GetThermalCameraRangeMax() const { return ThermalCameraRangeMax; }
+	float GetBackgroundTemperature() const { return BackgroundTemperature; }
+
+	// Direction toward the sun and the solar heating of a fully absorbing surface facing it, 0 at night
+	void GetSunHeating(FVector3f& OutDirectionToSun, float& OutIntensity) const;
+
+	UFUNCTION(BlueprintSetter)
+	void SetThermalCameraActive(bool bActive);
+
+	UFUNCTION(BlueprintSetter)
+	void SetThermalCameraRangeMin(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetThermalCameraRangeMax(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBackgroundTemperature(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetSkyTemperature(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBlur(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetNoiseSize(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetSensorResolution(FIntPoint Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetSensorUpscale(EThermalSensorUpscale Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetNoiseAmount(float Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetNoiseMode(EThermalNoiseMode Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetPalette(EThermalPalette Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetCold(FLinearColor Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetMid(FLinearColor Value);
+
+	UFUNCTION(BlueprintSetter)
+	void SetHot(FLinearColor Value);
+
+	// Queues parameters to be written to the MPC on the next tick
+	void MarkThermalSettingsDirty(EThermalSettingsDirty Flags);
+
+	// Broadcast once per thermal camera transition, thermal actors swap their materials in response
+	UPROPERTY(BlueprintAssignable, Category = "Logi")
+	FOnThermalModeChanged OnThermalModeChanged;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetThermalCameraActive, Category = "Logi")
+	bool ThermalCameraActive = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetThermalCameraRangeMin, Category = "Logi")
+	float ThermalCameraRangeMin = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetThermalCameraRangeMax, Category = "Logi")
+	float ThermalCameraRangeMax = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBackgroundTemperature, Category = "Logi")
+	float BackgroundTemperature = 25.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetSkyTemperature, Category = "Logi")
+	float SkyTemperature = 5.0f;
+
+	// 0-100, a Gaussian radius of up to 32 pixels, or the blend towards the fixed 7 tap blur in the legacy blur mode (see ULogiSettings::ThermalBlurMode)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBlur, Category = "Logi")
+	float Blur = 5.0f;
+
+	// Noise cells per sensor pixel, or per screen pixel without a sensor resolution
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetNoiseSize, Category = "Logi")
+	float NoiseSize = 1.0f;
+
+	// 0-100, no noise is computed at all at 0
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetNoiseAmount, Category = "Logi")
+	float NoiseAmount = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetNoiseMode, Category = "Logi")
+	EThermalNoiseMode NoiseMode = EThermalNoiseMode::Hash;
+
+	// Switching palettes only writes the MPC, PP_Logi_ThermalCamera samples every palette from one lookup texture
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPalette, Category = "Logi")
+	EThermalPalette Palette = EThermalPalette::Custom;
+
+	// Cold, Mid and Hot are the colors of the Custom palette
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetCold, Category = "Logi")
+	FLinearColor Cold = FLinearColor(0.0f, 0.0f, 1.0f, 1.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMid, Category = "Logi")
+	FLinearColor Mid = FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetHot, Category = "Logi")
+	FLinearColor Hot = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f);
+
+	UPROPERTY(EditAnywhere, Category = "Logi")
+	TSoftObjectPtr<UMaterialParameterCollection> ThermalSettings;
+
+	// Resolution of the simulated sensor, e.g. 320x256 or 640x512, 0 keeps the display resolution. The scene view extension forms
+	// the image at this size and upscales it, the post process material only lays its noise out on the sensor pixels.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetSensorResolution, Category = "Logi|Sensor", meta = (ClampMin = "0"))
+	FIntPoint SensorResolution = FIntPoint::ZeroValue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetSensorUpscale, Category = "Logi|Sensor")
+	EThermalSensorUpscale SensorUpscale = EThermalSensorUpscale::Nearest;
+
+	// Hours, drives the sun when no sun actor is set. The sun rises at 6 and sets at 18.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi|Sun", meta = (ClampMin = "0", ClampMax = "24"))
+	float TimeOfDay = 12.0f;
+
+	// Compass direction of the sun path in degrees, used with TimeOfDay
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi|Sun")
+	float SunAzimuth = 0.0f;
+
+	// Degrees a fully absorbing surface facing the sun at its highest is heated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi|Sun", meta = (ClampMin = "0"))
+	float SunIntensity = 15.0f;
+
+	// Directional light of the level. When set, its direction is used instead of TimeOfDay.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Logi|Sun")
+	TObjectPtr<AActor> Sun;
+
+private:
+	void BroadcastThermalModeChanged();
+
+	// Writes every dirty parameter to the MPC instance of this world and clears the mask
+	void FlushThermalSettings();
+
+	// Settings of the thermal image extension, normalized like the MPC parameters
+	FThermalImageSettings MakeThermalImageSettings() const;
+
+	EThermalSettingsDirty DirtyMask = EThermalSettingsDirty::All;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ThermalProfile.generated.h"
+
+class UCurveFloat;
+
+/**
+ * Temperature over time for thermal actors, e.g. an engine that spikes and settles or a muzzle that flashes and decays.
+ * The curve is a 0-1 blend between the base and max temperature of the actor playing it, so one profile fits actors
+ * of any temperature range. It is baked to a fixed size lookup table when loaded, or on first play when it was created
+ * at runtime. The thermal world subsystem evaluates the tables of every playing actor in one batch.
+ * In the editor the table is baked again whenever the curve or its keys are edited, actors playing the profile follow the new table.
+ */
+UCLASS(BlueprintType)
+class LOGIRUNTIME_API UThermalProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Samples of the baked lookup table
+	static constexpr int32 LUTSize = 64;
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Samples the curve into the lookup table, called when loaded and when the curve is edited.
+	// Game thread only. Editor edits wait for the simulation of every world first and refresh the actors playing the profile
+	// afterwards. Mass processors read the table inside the world tick and must not run concurrently with an edit of the asset.
+	void Bake();
+
+	// Blend between base and max temperature at the given time since the profile started
+	float Evaluate(float Time) const;
+
+	const TArray<float>& GetLUT() const { return LUT; }
+	float GetDuration() const { return Duration; }
+	bool IsLooping() const { return bLoop; }
+
+	// Time in seconds since the profile started to the 0-1 blend between base and max temperature
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	TObjectPtr<UCurveFloat> Curve;
+
+	// Starts over at the end of the curve instead of holding its last value
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Logi")
+	bool bLoop = false;
+
+private:
+#if WITH_EDITOR
+	// Keys edited in the curve editor change the curve asset, not a property of the profile
+	void BindCurveUpdate();
+
+	// Bakes between simulation steps and hands the new table to every world
+	void Rebake();
+
+	FDelegateHandle CurveUpdateHandle;
+#endif
+
+	UPROPERTY(Transient)
+	TArray<float> LUT;
+
+	UPROPERTY(Transient)
+	float Duration = 0.0f;
+};
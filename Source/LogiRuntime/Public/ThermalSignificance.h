@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UThermalComponent;
+
+// How often a thermal component is sent to the GPU, from its distance, screen size and visibility
+enum class EThermalSignificance : uint8
+{
+	EveryFrame,
+	Every4thFrame,
+	Every16thFrame,
+
+	// Not rendered recently or too small to see, only updated again once it becomes significant
+	Frozen,
+
+	Num
+};
+
+namespace ThermalSignificance
+{
+	// Significance of a component seen from the given view locations
+	LOGIRUNTIME_API EThermalSignificance Evaluate(const UThermalComponent& Component, TConstArrayView<FVector> ViewLocations);
+
+	// Staggers the components of one bucket over the frames by their index
+	LOGIRUNTIME_API bool ShouldUpdate(EThermalSignificance Significance, int32 Index, uint64 FrameNumber);
+
+	// Number of components to evaluate per frame, the rest are evaluated on the following frames
+	LOGIRUNTIME_API int32 GetEvaluationsPerFrame();
+
+	LOGIRUNTIME_API bool IsEnabled();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid of the thermal components that exchange heat with their neighbours. Entry indices match the
+ * temperature store, entries that do not exchange heat are kept out of the cells. Moving an entry only touches
+ * the grid when it crosses into another cell, so the grid is maintained incrementally instead of rebuilt each frame.
+ */
+struct LOGIRUNTIME_API FThermalSpatialHash
+{
+	// Adds an entry that is not in the grid yet, keeps the indices in step with the temperature store
+	int32 Add();
+
+	// Moves the last entry into the removed slot, like TArray::RemoveAtSwap
+	void RemoveAtSwap(int32 Index);
+
+	void Reset();
+
+	// Inserts the entry into the grid or moves it, cheap when it stays in its cell
+	void Update(int32 Index, const FVector& Location);
+
+	// Takes the entry out of the grid
+	void Remove(int32 Index);
+
+	// Changing the cell size re-buckets every entry
+	void SetCellSize(float InCellSize);
+
+	bool Contains(const int32 Index) const { return HashedEntries[Index]; }
+	int32 FindNext(const int32 StartIndex) const { return HashedEntries.FindFrom(true, StartIndex); }
+
+	int32 Num() const { return Locations.Num(); }
+	int32 NumHashed() const { return NumHashedEntries; }
+
+	const FVector& GetLocation(const int32 Index) const { return Locations[Index]; }
+
+	// Writes the nearest entries within Radius of the entry, at most MaxNeighbours of them, with their distances.
+	// Thread safe while the grid is not modified.
+	void FindNeighbours(int32 Index, float Radius, int32 MaxNeighbours, TArray<int32, TInlineAllocator<16>>& OutNeighbours, TArray<float, TInlineAllocator<16>>& OutDistances) const;
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(int32 Index, const FIntVector& Cell);
+	void RemoveFromCell(int32 Index, const FIntVector& Cell);
+
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	TArray<FVector> Locations;
+	TArray<FIntVector> EntryCells;
+	TBitArray<> HashedEntries;
+	int32 NumHashedEntries = 0;
+
+	float CellSize = 500.0f;
+};
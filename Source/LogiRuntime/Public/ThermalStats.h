@@ -0,0 +1,6 @@
+#pragma once
+
+#include "Stats/Stats.h"
+
+// Stat group for all Logi runtime counters, shown with "stat Logi"
+DECLARE_STATS_GROUP(TEXT("Logi"), STATGROUP_Logi, STATCAT_Advanced);
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FThermalAmbientVolume;
+struct FThermalSpatialHash;
+class UThermalProfile;
+
+/**
+ * Temperatures of every thermal component in a world, kept as contiguous arrays (structure of arrays).
+ * The temperatures are normalized to the thermal camera range in one vectorized pass, and only when
+ * the range or a temperature has changed. Entry indices match the thermal component indices of the world subsystem.
+ * Entries with time constants heat up toward their max temperature while active and cool down otherwise (Simulate).
+ * Entries playing a thermal profile follow its baked lookup table instead (AdvanceProfiles).
+ * Sunlit entries are shown warmer by their solar heating, which is kept apart from the current temperature (ApplySolarHeating).
+ * Simulate, AdvanceProfiles and ExchangeHeat may run on a worker thread, every other call has to wait for them to finish.
+ * GetCurrent reads the temperatures of the last Publish, so gameplay never sees a half simulated step.
+ */
+struct LOGIRUNTIME_API FThermalTemperatureStore
+{
+	// Adds an entry and returns its index, new entries have priority
+	int32 Add(float BaseTemperature, float CurrentTemperature, float MaxTemperature);
+
+	// Moves the last entry into the removed slot, like TArray::RemoveAtSwap
+	void RemoveAtSwap(int32 Index);
+
+	void Reset();
+
+	void SetTemperatures(int32 Index, float BaseTemperature, float CurrentTemperature, float MaxTemperature);
+
+	// Time constants in seconds, 0 keeps the current temperature where gameplay puts it
+	void SetTransient(int32 Index, float HeatingTimeConstant, float CoolingTimeConstant, bool bCoolToAmbient);
+
+	// Active entries heat up toward their max temperature, inactive entries cool down
+	void SetActive(int32 Index, bool bActive);
+
+	bool IsActive(const int32 Index) const { return ActiveEntries[Index]; }
+
+	bool IsCoolToAmbient(const int32 Index) const { return CoolToAmbientEntries[Index]; }
+
+	// Advances every transient entry by DeltaTime in parallel. Entries that moved get priority.
+	// Entries that cool to ambient cool toward AmbientTemperature plus their sampled ambient offset.
+	void Simulate(float DeltaTime, float AmbientTemperature);
+
+	// Samples the ambient offset of every entry that cools to ambient at its location, in parallel.
+	// Locations is indexed like the entries, only the entries that cool to ambient are read.
+	void SampleAmbient(const FThermalAmbientVolume& AmbientVolume, TConstArrayView<FVector3f> Locations);
+
+	// Scales the heat exchange rate of the entry, from its thermal material class
+	void SetConductivity(const int32 Index, const float InConductivity) { Conductivity[Index] = FMath::Max(InConductivity, 0.0f); }
+
+	// Moves the current temperature of every entry in the grid toward its nearest neighbours, in parallel.
+	// Coefficient is the rate per second at which an entry closes the gap to its neighbours, scaled by its conductivity.
+	void ExchangeHeat(const FThermalSpatialHash& SpatialHash, float DeltaTime, float Radius, float Coefficient, int32 MaxNeighbours);
+
+	// Restarts the entry on the profile, nullptr stops it. The caller keeps the profile alive while it plays.
+	void PlayProfile(int32 Index, const UThermalProfile* Profile);
+
+	// Picks up a new bake of the profile, every entry playing it keeps its time and follows the new table on the next AdvanceProfiles
+	void RefreshProfile(const UThermalProfile* Profile);
+
+	// Advances every playing profile by DeltaTime and writes the blended temperatures, finished profiles stop
+	void AdvanceProfiles(float DeltaTime);
+
+	// Seconds the profile of the entry has played, -1 when it plays none
+	float GetProfileTime(const int32 Index) const { return EntryProfileSlots[Index] != INDEX_NONE ? PlayingTimes[EntryProfileSlots[Index]] : -1.0f; }
+
+	// Moves the playing profile of the entry to Time, the temperature follows on the next AdvanceProfiles
+	void SetProfileTime(int32 Index, float Time);
+
+	// Absorptivity 0-1 of the surface facing along SurfaceNormal, 0 keeps the entry out of the solar pass
+	void SetSolar(int32 Index, float Absorptivity, const FVector3f& SurfaceNormal);
+
+	bool IsSolar(const int32 Index) const { return SolarAbsorptivity[Index] > 0.0f; }
+
+	// Turns the surface of a sunlit entry, returns false and keeps the old normal while the two are within MinCos of each other
+	bool SetSolarNormal(int32 Index, const FVector3f& SurfaceNormal, float MinCos);
+
+	// Recomputes the solar heating of every sunlit entry in one vectorized pass, entries whose heating changed get priority.
+	// Intensity is the heating in degrees of a fully absorbing surface facing the sun.
+	void ApplySolarHeating(const FVector3f& DirectionToSun, float Intensity);
+
+	// Recomputes the solar heating of the listed entries only, e.g. movable actors that turned while the sun stood still
+	void ApplySolarHeating(TConstArrayView<int32> Indices, const FVector3f& DirectionToSun, float Intensity);
+
+	bool HasSolarEntries() const { return NumSolarEntries > 0; }
+
+	bool HasPlayingProfiles() const { return PlayingEntries.Num() > 0; }
+
+	bool HasTransientEntries() const { return NumTransientEntries > 0; }
+
+	// Copies the simulated current temperatures to the published ones, once the simulation has finished
+	void Publish();
+
+	float GetCurrent(const int32 Index) const { return PublishedCurrent[Index]; }
+
+	// Current temperature plus solar heating, the temperature the thermal camera shows
+	float GetSurfaceCurrent(const int32 Index) const { return PublishedCurrent[Index] + SolarHeat[Index]; }
+
+	// Changing the range marks every entry dirty, returns false when the range is unchanged
+	bool SetRange(float InRangeMin, float InRangeMax);
+
+	// Normalizes every entry if anything changed since the last call, returns false when there was nothing to do
+	bool Normalize();
+
+	// Entries whose temperature changed or that were just added, sent before the rest
+	bool HasPriority(const int32 Index) const { return PriorityEntries[Index]; }
+	int32 FindNextPriority(const int32 StartIndex) const { return PriorityEntries.FindFrom(true, StartIndex); }
+	void MarkPriority(int32 Index);
+
+	// Entries that only need an update because the range changed
+	int32 FindNextDirty(const int32 StartIndex) const { return DirtyEntries.FindFrom(true, StartIndex); }
+
+	bool IsPending(const int32 Index) const { return PriorityEntries[Index] || DirtyEntries[Index]; }
+
+	// Called once the normalized temperatures of an entry have been sent to the GPU path
+	void ClearDirty(int32 Index);
+
+	// Takes a pending entry out of the update until Thaw, changes to a frozen entry are not marked
+	void Freeze(int32 Index);
+
+	// Puts a frozen entry back in front of the update, entries that are not frozen are left alone
+	void Thaw(int32 Index);
+	void ThawAll();
+
+	// Number of entries still waiting to be sent to the GPU path, frozen entries are not counted
+	int32 GetNumPending() const { return NumPendingEntries; }
+
+	int32 GetNumFrozen() const { return NumFrozenEntries; }
+
+	int32 Num() const { return Base.Num(); }
+
+	// Temperatures of every entry, for snapshots
+	TConstArrayView<float> GetBaseTemperatures() const { return Base; }
+	TConstArrayView<float> GetCurrentTemperatures() const { return PublishedCurrent; }
+	TConstArrayView<float> GetMaxTemperatures() const { return Max; }
+
+	float GetNormalizedBase(const int32 Index) const { return NormalizedBase[Index]; }
+	float GetNormalizedCurrent(const int32 Index) const { return NormalizedCurrent[Index]; }
+	float GetNormalizedMax(const int32 Index) const { return NormalizedMax[Index]; }
+
+	// UKismetMathLibrary::NormalizeToRange for every value (up to rounding), four values per instruction
+	static void NormalizeToRange(const float* RESTRICT Values, float* RESTRICT OutValues, int32 Count, float RangeMin, float RangeMax);
+
+private:
+	// Gives an entry whose temperature moved priority without touching NumPendingEntries, returns true when it was not pending before.
+	// Parallel passes call it from chunks that own whole bit array words and add up the returned counts afterwards.
+	bool MarkMoved(int32 Index);
+
+	TArray<float> Base;
+	TArray<float> Current;
+	TArray<float> Max;
+
+	// Current temperatures of the last finished simulation, read while the next one runs
+	TArray<float> PublishedCurrent;
+
+	// Inverse time constants, 0 for entries that do not heat up or cool down on their own
+	TArray<float> HeatingRate;
+	TArray<float> CoolingRate;
+	TBitArray<> ActiveEntries;
+	TBitArray<> CoolToAmbientEntries;
+	int32 NumTransientEntries = 0;
+
+	// Offset of the ambient volume at each entry from the last SampleAmbient
+	TArray<float> AmbientOffset;
+
+	// Solar absorptivity and surface normal of every entry, and the heating they got from the last solar pass
+	TArray<float> SolarAbsorptivity;
+	TArray<float> SolarNormalX;
+	TArray<float> SolarNormalY;
+	TArray<float> SolarNormalZ;
+	TArray<float> SolarHeat;
+	int32 NumSolarEntries = 0;
+
+	// Scratch of ApplySolarHeating and Normalize
+	TArray<float> SolarScratch;
+
+	// Entries playing a profile, packed so the batch only touches playing entries
+	TArray<int32> PlayingEntries;
+	TArray<float> PlayingTimes;
+	TArray<float> PlayingLUTScales;
+	TArray<const UThermalProfile*> PlayingProfiles;
+
+	// Slot of each entry in the playing arrays, INDEX_NONE when it plays no profile
+	TArray<int32> EntryProfileSlots;
+
+	// Scratch of AdvanceProfiles, lookup table coordinate of every playing entry
+	TArray<float> ProfileCoordinates;
+
+	TArray<float> Conductivity;
+
+	// Scratch of ExchangeHeat, every delta is computed from the temperatures before the exchange
+	TArray<float> HeatExchangeDelta;
+
+	TArray<float> NormalizedBase;
+	TArray<float> NormalizedCurrent;
+	TArray<float> NormalizedMax;
+
+	// Entries whose normalized temperatures have not been sent to the GPU path yet
+	TBitArray<> PriorityEntries;
+	TBitArray<> DirtyEntries;
+	int32 NumPendingEntries = 0;
+
+	// Entries that were pending when the update froze them, they are in neither of the arrays above
+	TBitArray<> FrozenEntries;
+	int32 NumFrozenEntries = 0;
+
+	// Entries or the range changed since the last Normalize
+	bool bNeedsNormalize = false;
+
+	float RangeMin = 0.0f;
+	float RangeMax = 1.0f;
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ThermalAmbientVolume.h"
+#include "ThermalSignificance.h"
+#include "ThermalSpatialHash.h"
+#include "ThermalTemperatureStore.h"
+#include "ThermalWorldSubsystem.generated.h"
+
+class AThermalController;
+class FThermalSceneViewExtension;
+struct FThermalImageSettings;
+class UThermalComponent;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UTexture2D;
+class UThermalProfile;
+
+/**
+ * Owns every thermal component in the world and updates them in one native pass,
+ * replacing the per-actor Logi_UpdateThermalMaterial blueprint call from Event Tick.
+ * Only components whose normalized temperatures changed are sent to the GPU, within a per-frame
+ * time budget (Logi.Thermal.UpdateBudgetUs). Changed and newly registered components go first, and
+ * far away or hidden components are updated less often (Logi.Thermal.Significance.*).
+ * Heating and cooling of transient components is integrated at a fixed rate (Logi.Thermal.Transient.*),
+ * together with the heat exchange between nearby components (Logi.Thermal.HeatExchange.*). The steps of a frame run
+ * on the task graph while the game thread works on the next frame, their results are sent to the GPU at the end of it.
+ * Sunlit components are heated by the sun of the controller in one batch whenever the sun turns, movable sunlit actors that
+ * turn on their own only recompute their own heating (Logi.Thermal.Solar.*).
+ * Components that cool to ambient cool toward the ambient volume at their location, a sparse grid of offsets from the
+ * background temperature that heat sources stamp into (Logi.Thermal.Ambient.*).
+ * The thermal state of the world can be saved to a compact binary snapshot and restored, keyed by the thermal GUID of each component.
+ * When ULogiSettings::ThermalImageMode selects it, the thermal image of the world is formed by a scene view extension instead of PP_Logi_ThermalCamera.
+ */
+UCLASS()
+class LOGIRUNTIME_API UThermalWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem / UTickableWorldSubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by thermal components on BeginPlay and EndPlay
+	void RegisterThermalComponent(UThermalComponent* Component);
+	void UnregisterThermalComponent(UThermalComponent* Component);
+
+	int32 GetNumThermalComponents() const { return ThermalComponents.Num(); }
+
+	// Copies the thermal state of a registered component into the temperature store
+	void UpdateTemperatures(const UThermalComponent& Component);
+
+	// Copies the heating, cooling and heat exchange settings of a registered component into the temperature store
+	void UpdateTransient(const UThermalComponent& Component);
+
+	// Copies the absorptivity and orientation of a registered component into the temperature store
+	void UpdateSolar(const UThermalComponent& Component);
+
+	// Starts the profile of a registered component, or stops it when the component has none
+	void PlayThermalProfile(const UThermalComponent& Component);
+
+	// Current temperature of a registered component, including heating and cooling
+	float GetCurrentTemperature(const UThermalComponent& Component) const;
+
+	// Seconds the profile of a registered component has played, -1 when it plays none
+	float GetProfileTime(const UThermalComponent& Component);
+
+	// Fixed steps simulated since the world began play and the time left over for the next one, both kept by thermal snapshots
+	int64 GetSimulatedSteps() const { return SimulatedSteps; }
+	float GetTransientTimeAccumulator() const { return TransientTimeAccumulator; }
+
+	// Moves a registered component to the front of the next update, e.g. when it just became visible
+	void PrioritizeThermalComponent(const UThermalComponent& Component);
+
+	// Adds TemperatureOffset degrees to the ambient air at Location, falling off linearly to 0 at Radius, e.g. a warm
+	// interior, a cold cellar or an exhaust. Negative offsets cool the air, stamps add up.
+	UFUNCTION(BlueprintCallable, Category = "Logi|Ambient")
+	void StampAmbientTemperature(const FVector& Location, float Radius, float TemperatureOffset);
+
+	// Resets the ambient air of the whole world to the background temperature
+	UFUNCTION(BlueprintCallable, Category = "Logi|Ambient")
+	void ClearAmbientTemperature();
+
+	// Background temperature of the controller plus the ambient volume at Location
+	UFUNCTION(BlueprintPure, Category = "Logi|Ambient")
+	float GetAmbientTemperature(const FVector& Location) const;
+
+	// Writes the temperatures, heating state and profile time of every registered component and the simulation time
+	// to a versioned binary snapshot. Temperatures are quantized to 16 bits over the range of the world.
+	UFUNCTION(BlueprintCallable, Category = "Logi|Snapshot")
+	void SaveThermalSnapshot(TArray<uint8>& OutData);
+
+	// Restores a snapshot of SaveThermalSnapshot onto the registered components with the same thermal GUID.
+	// Components missing from the snapshot keep their state. Returns false when the data is not a snapshot this version can read.
+	UFUNCTION(BlueprintCallable, Category = "Logi|Snapshot")
+	bool RestoreThermalSnapshot(const TArray<uint8>& Data);
+
+	// Called by thermal controllers on BeginPlay and EndPlay. Components without a controller are assigned the new one.
+	void RegisterThermalController(AThermalController* Controller);
+	void UnregisterThermalController(AThermalController* Controller);
+
+	// Material of one skeletal mesh material slot, shared by every skeletal thermal mesh in the world.
+	// nullptr when the skeletal thermal material can not be loaded.
+	UMaterialInterface* GetSkeletalSectionMaterial(int32 MaterialSlot);
+
+	// Controller of the world, the first one that was registered. nullptr until a controller has begun play.
+	AThermalController* GetThermalController() const;
+
+	// Hands the controller settings to the thermal image extension. False when the world has none and PP_Logi_ThermalCamera forms the image.
+	bool UpdateThermalImage(const FThermalImageSettings& Settings);
+
+	// Waits for the simulation of every world, e.g. before an asset the running steps read is changed in the editor
+	static void WaitForSimulationInAllWorlds();
+
+	// Lets every world pick up a new bake of the profile, e.g. after its curve was edited while it plays
+	static void RefreshProfileInAllWorlds(const UThermalProfile& Profile);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RemoveThermalComponentAt(int32 Index);
+
+	// Launches the fixed steps of profiles, heating, cooling and heat exchange that fit in the time since the last frame
+	void SimulateTransient(float DeltaTime, const AThermalController& Controller);
+
+	// Writes the location of every component that cools to ambient to AmbientLocations
+	void GatherAmbientLocations();
+
+	// Blocks until the steps launched by SimulateTransient have finished and publishes their temperatures.
+	// Everything that touches the temperature store or the spatial hash has to call this first.
+	void WaitForSimulation();
+
+	// Sends the pending normalized temperatures to the GPU, within the frame budget
+	void UpdateThermalComponents(const AThermalController* Controller);
+
+	// Runs the solar pass when the sun has moved far enough or sunlit components were added,
+	// movable sunlit components that turned on their own only recompute their own heating
+	void UpdateSolarHeating(const AThermalController& Controller);
+
+	// Adds the component at Index to MovableSolarIndices or takes it out
+	void SetMovableSolar(int32 Index, bool bMovableSolar);
+
+	// Moves the heat exchanging components in the spatial hash to the location of their owners
+	void UpdateSpatialHash();
+
+	void PlayProfile(int32 Index, UThermalProfile* Profile);
+
+	// Evaluates the significance of the next slice of components
+	void UpdateSignificance();
+
+	// Sends the normalized temperatures of one component to the active GPU path
+	void UpdateThermalComponent(UThermalComponent& Component, const AThermalController* WorldController);
+	void UpdateCustomPrimitiveData(const UThermalComponent& Component, const FVector& Temperatures);
+
+	// Writes the actor and per slot temperatures of the skeletal meshes of one component
+	void UpdateSkeletalSections(const UThermalComponent& Component, const AThermalController& Controller, const FVector& Temperatures);
+
+	// Registered components, each component stores its own index for O(1) removal
+	UPROPERTY()
+	TArray<TObjectPtr<UThermalComponent>> ThermalComponents;
+
+	// One instance of the skeletal thermal material per material slot, selecting the temperature of that slot
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMaterialInstanceDynamic>> SkeletalSectionMaterials;
+
+	// Registered controllers, the first is handed out to thermal components
+	UPROPERTY()
+	TArray<TObjectPtr<AThermalController>> ThermalControllers;
+
+	// Temperatures of the registered components, indexed like ThermalComponents
+	FThermalTemperatureStore TemperatureStore;
+
+	// Where the round robin update continues on the next frame
+	int32 UpdateCursor = 0;
+
+	// Heat exchanging components, indexed like ThermalComponents
+	FThermalSpatialHash SpatialHash;
+
+	// Ambient air temperature offsets stamped by heat sources
+	FThermalAmbientVolume AmbientVolume;
+
+	// Locations the simulation task samples the ambient volume at, indexed like ThermalComponents
+	TArray<FVector3f> AmbientLocations;
+
+	// The volume changed since the last sample, set when it was cleared so the offsets go back to 0
+	bool bAmbientVolumeChanged = false;
+
+	// Sun of the last solar pass
+	FVector3f SolarDirection = FVector3f::ZeroVector;
+	float SolarIntensity = 0.0f;
+	bool bSolarDirty = false;
+
+	// Sunlit components with a movable root, packed so the solar update does not visit every component each frame.
+	// Taken when the component registers or its solar settings are copied, a root that changes mobility later is not picked up.
+	TArray<int32> MovableSolarIndices;
+
+	// Slot of each component in MovableSolarIndices, INDEX_NONE when it is not in there. Indexed like ThermalComponents.
+	TArray<int32> MovableSolarSlots;
+
+	// Scratch of UpdateSolarHeating, movable sunlit components that turned this frame
+	TArray<int32> TurnedSolarIndices;
+
+	// Time not yet simulated, less than one fixed step
+	float TransientTimeAccumulator = 0.0f;
+
+	// Fixed steps launched since the world began play
+	int64 SimulatedSteps = 0;
+
+	// Steps running on the task graph, nullptr when the store belongs to the game thread
+	FGraphEventRef SimulationTask;
+
+	// Waits for the simulation before garbage collection, the running steps read the baked profiles
+	FDelegateHandle PreGarbageCollectHandle;
+
+	// Forms the thermal image natively, nullptr in the post process material mode
+	TSharedPtr<FThermalSceneViewExtension, ESPMode::ThreadSafe> ThermalImageExtension;
+
+	// ULogiSettings::BlueNoiseTexture, loaded with the extension and kept alive while the render thread samples it
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> BlueNoiseTexture;
+
+	// Update rate of each component, indexed like ThermalComponents
+	TArray<EThermalSignificance> Significances;
+	int32 SignificanceCursor = 0;
+	int32 NumSignificances[static_cast<int32>(EThermalSignificance::Num)] = {};
+};